@@ -25,9 +25,9 @@ int main()
 
   HyPas hp = {{{// hp
 
-                "MIC1_PAD2_PLU1_LIW1_MIW0_WOS0_VEW1",
-                "MIC1_PAD1_PLU0_LIW0_MIW0_WOS0_VEW1",
-                "UNR128_GAL2_PUN0_ICE1_IWI1_SZT1_MAD0_NAW16_UFO0_MAC256_SKW9_AFI0_MIA1"}}};
+                "MIC1_PAD2_PLU1_LIW1_MIW0_WOS0_VEW1_SWZ0",
+                "MIC1_PAD1_PLU0_LIW0_MIW0_WOS0_VEW1_SWZ0",
+                "UNR128_GAL2_PUN0_ICE1_IWI1_SZT1_MAD0_NAW16_UFO0_MAC256_SKW9_AFI0_MIA1_DBL0_PFR0_STK0_FUS0"}}};
 
   //"MIC4_PAD1_PLU0_LIW0_MIW0_WOS0_VEW4",
   //"MIC2_PAD1_PLU0_LIW1_MIW1_WOS0_VEW1",
@@ -46,6 +46,9 @@ int main()
   dev::TinyTwo   boa(gg, offsets, mowri, devhint);
 
   boa.accuracy_test(hp);
+  // without the full CPU GEMM, on a sample of C and with random projections
+  boa.accuracy_test(hp, Verification::E::SAMPLED);
+  boa.accuracy_test(hp, Verification::E::FREIVALDS);
   mowri << "\ndone.\n";
   return 0;
 }
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <iostream>
+#include <miopengemm/oclutil.hpp>
+#include <miopengemm/outputwriter.hpp>
+#include <miopengemm/roofline.hpp>
+
+// Calibrate the bandwidth of the roofline (see roofline.hpp) : measure the global memory
+// bandwidth of the default OpenCL device with buffer copies of increasing size, and compare it
+// to the estimate used when MIOPENGEMM_BANDWIDTH is not set.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  owrite::Writer                 mowri(Ver::E::TERMINAL, "");
+  oclutil::CommandQueueInContext tgcq(mowri, CL_QUEUE_PROFILING_ENABLE, {}, "bandwidth");
+  oclutil::DevInfo               devinfo(tgcq.command_queue);
+
+  double best = 0;
+  for (size_t n_bytes = size_t(16) << 20; n_bytes <= size_t(256) << 20; n_bytes *= 2)
+  {
+    if (2 * n_bytes > devinfo.device_global_mem_size / 2)
+    {
+      break;
+    }
+    best = std::max(best, roofline::measure_bandwidth(tgcq.command_queue, n_bytes, 10, mowri));
+  }
+
+  auto peaks = roofline::get_peaks(devinfo, 'f');
+  std::cout << '\n'
+            << devinfo.device_name << " : measured " << best << " GB/s, estimated "
+            << peaks.bandwidth << " GB/s (0 if unknown). To use the measured bandwidth :\n"
+            << "export MIOPENGEMM_BANDWIDTH=" << static_cast<size_t>(best) << std::endl;
+
+  return 0;
+}
@@ -11,9 +11,9 @@ int main()
   // Geometry gg("tC0_tA0_tB0_colMaj1_m4096_n7000_k4096_lda4096_ldb4096_ldc4096_ws0_f32");
   Geometry gg = MIOpenGEMM::get_squareNN_geometry<float>(5100);
 
-  HyPas hp{{{"MIC8_PAD1_PLU0_LIW0_MIW1_WOS0_VEW2",
-             "MIC5_PAD2_PLU0_LIW0_MIW1_WOS0_VEW1",
-             "UNR16_GAL3_PUN0_ICE1_IWI1_SZT0_MAD0_NAW16_UFO0_MAC256_SKW10_AFI1_MIA0"}}};
+  HyPas hp{{{"MIC8_PAD1_PLU0_LIW0_MIW1_WOS0_VEW2_SWZ0",
+             "MIC5_PAD2_PLU0_LIW0_MIW1_WOS0_VEW1_SWZ0",
+             "UNR16_GAL3_PUN0_ICE1_IWI1_SZT0_MAD0_NAW16_UFO0_MAC256_SKW10_AFI1_MIA0_DBL0_PFR0_STK0_FUS0"}}};
 
   // HyPas hp({"MIC8_PAD1_PLU0_LIW0_MIW1_WOS0_VEW2",
   //"MIC5_PAD2_PLU0_LIW0_MIW1_WOS0_VEW1",
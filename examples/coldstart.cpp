@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/timer.hpp>
+
+// Time the initialisation of the kernel cache, the main start-up cost of the library for
+// short-lived jobs. The first call constructs the cache, later calls return it.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  Timer timer;
+  timer.start();
+  auto&& kc      = get_kernel_cache();
+  auto   t_first = timer.get_elapsed();
+
+  timer.start();
+  get_kernel_cache();
+  auto t_second = timer.get_elapsed();
+
+  std::cout << "kernel cache with " << kc.get_keys().size() << " entries initialised in "
+            << 1000. * t_first << " [ms] (subsequent call : " << 1000. * t_second << " [ms])"
+            << std::endl;
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <miopengemm/cpugemm.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/setabcw.hpp>
+#include <miopengemm/timer.hpp>
+
+// Benchmark the CPU GEMM (blocked, vectorised and multithreaded, or OpenBLAS) against the
+// naive 3-fors GEMM, and check that they agree.
+template <typename TFloat>
+void bench(const MIOpenGEMM::Geometry& gg)
+{
+  using namespace MIOpenGEMM;
+
+  Offsets                  toff = get_padding_offsets();
+  std::vector<TFloat>      a;
+  std::vector<TFloat>      b;
+  std::vector<TFloat>      c;
+  setabcw::MatData<TFloat> v_abc{&a, &b, &c};
+  owrite::Writer           silent(Ver::E::SILENT, "");
+  Timer                    timer;
+
+  setabcw::set_abc<TFloat>(v_abc, gg, toff);
+  std::vector<TFloat> c_3fors = c;
+
+  timer.start();
+  cpugemm::gemm<TFloat>(gg, toff, a.data(), b.data(), c.data(), 0.7, 0.3, silent);
+  double t_gemm = timer.get_elapsed();
+
+  timer.start();
+  cpugemm::gemm_3fors<TFloat>(gg, toff, a.data(), b.data(), c_3fors.data(), 0.7, 0.3, silent);
+  double t_3fors = timer.get_elapsed();
+
+  double max_diff = 0;
+  for (size_t i = 0; i < c.size(); ++i)
+  {
+    max_diff = std::max<double>(max_diff, std::abs(c[i] - c_3fors[i]));
+  }
+
+  std::cout << gg.get_string() << "\n  gemm : " << std::setw(9) << gg.get_gflops(t_gemm)
+            << " [GFlop/s]   3-fors : " << std::setw(9) << gg.get_gflops(t_3fors)
+            << " [GFlop/s]   speedup : " << std::setw(7) << t_3fors / t_gemm
+            << "   max difference : " << max_diff << std::endl;
+}
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  for (size_t m : {256, 512, 1024})
+  {
+    for (bool tA : {false, true})
+    {
+      for (bool tB : {false, true})
+      {
+        bench<float>(get_padded_geometry<float>(true, tA, tB, false, m, m + 3, m - 5, 0));
+      }
+    }
+    bench<double>(get_padded_geometry<double>(false, false, true, true, m, m + 3, m - 5, 0));
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <miopengemm/bundle.hpp>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/timer.hpp>
+
+// Throughput of kernel string generation, over all solutions in the kernel cache.
+// Find and the first call of a geometry both generate kernel strings on the hot path.
+
+using namespace MIOpenGEMM;
+
+namespace
+{
+
+class Case
+{
+  public:
+  HyPas    hp;
+  Geometry gg;
+};
+
+// seconds to generate all cases, and the total length of the kernel strings
+double get_time(const std::vector<Case>& cases, bool indent, size_t& n_bytes)
+{
+  n_bytes = 0;
+  Timer timer;
+  timer.start();
+  for (auto& x : cases)
+  {
+    kerngen::Bundle bundle(x.hp, x.gg, indent);
+    for (auto& kblob : bundle.v_tgks)
+    {
+      n_bytes += kblob.kernstr.size();
+    }
+  }
+  return timer.get_elapsed();
+}
+
+void report(const std::string& what, size_t n_cases, double t, size_t n_bytes)
+{
+  std::cout << what << " : " << n_cases / t << " bundles/s, " << 1e-6 * n_bytes / t << " MB/s"
+            << std::endl;
+}
+}
+
+int main()
+{
+  auto& kc = get_kernel_cache();
+
+  std::vector<Case> cases;
+  for (auto& ck : kc.get_keys())
+  {
+    cases.push_back({kc.at(ck), ck.gg});
+  }
+  std::cout << cases.size() << " solutions" << std::endl;
+
+  Timer timer;
+  timer.start();
+  for (auto& x : cases)
+  {
+    DerivedParams dp(x.hp, x.gg);
+  }
+  double t = timer.get_elapsed();
+  report("derived parameters only", cases.size(), t, 0);
+
+  size_t n_bytes;
+  t = get_time(cases, true, n_bytes);
+  report("indented               ", cases.size(), t, n_bytes);
+  t = get_time(cases, false, n_bytes);
+  report("not indented           ", cases.size(), t, n_bytes);
+  return 0;
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <miopengemm/bundle.hpp>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/graph.hpp>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/miogemm.hpp>
+#include <miopengemm/nearest.hpp>
+#include <miopengemm/programcacher.hpp>
+#include <miopengemm/simdevice.hpp>
+#include <miopengemm/timer.hpp>
+
+// Latency of each host side stage between xgemm and the enqueueing of its kernels, a guard
+// against regressions of the host overhead. Without arguments no GPU is needed : ProgramCacher
+// compiles on a simulated device (see simdevice.hpp), whose Programs::run only advances a
+// clock. With --gpu, ProgramCacher and Programs::run use the default OpenCL device, and the
+// times of get_ID (miss) include the OpenCL compilation. On the simulated device, a miss also
+// generates a Bundle for the modelled times of the kernels.
+
+using namespace MIOpenGEMM;
+
+namespace
+{
+
+// each sample lasts at least this long [s], calls being batched, for the timer's resolution
+const double min_sample_time = 50e-6;
+
+// n_samples times [us] of one call of f. after_sample is called between samples, untimed.
+std::vector<double> get_samples(const std::function<void()>& f,
+                                size_t                       n_samples,
+                                bool                         batch,
+                                const std::function<void()>& after_sample = []() {})
+{
+  Timer timer;
+  // warm up, and estimate the number of calls per sample
+  timer.start();
+  f();
+  double t_first = timer.get_elapsed();
+  after_sample();
+  size_t n_calls = batch ? std::max<size_t>(1, min_sample_time / std::max(t_first, 1e-9)) : 1;
+
+  std::vector<double> samples;
+  for (size_t s = 0; s < n_samples; ++s)
+  {
+    timer.start();
+    for (size_t c = 0; c < n_calls; ++c)
+    {
+      f();
+    }
+    samples.push_back(1e6 * timer.get_elapsed() / n_calls);
+    after_sample();
+  }
+  return samples;
+}
+
+void report(const std::string& stage, std::vector<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  double mean = 0;
+  for (auto x : samples)
+  {
+    mean += x / samples.size();
+  }
+  double var = 0;
+  for (auto x : samples)
+  {
+    var += (x - mean) * (x - mean) / samples.size();
+  }
+  auto get_percentile = [&samples](double p) {
+    return samples[static_cast<size_t>(p * (samples.size() - 1))];
+  };
+
+  std::cout << std::left << std::setw(26) << stage << std::right << std::fixed
+            << std::setprecision(2) << std::setw(12) << samples[0] << std::setw(12)
+            << get_percentile(0.5) << std::setw(12) << get_percentile(0.9) << std::setw(12)
+            << mean << std::setw(12) << std::sqrt(var) << std::setw(8) << samples.size()
+            << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  bool use_gpu = argc > 1 && std::string(argv[1]) == "--gpu";
+
+  owrite::Writer silent(Ver::E::SILENT, "");
+  Geometry       gg("tC0_tA0_tB0_colMaj1_m1760_n128_k1760_lda1760_ldb1760_ldc1760_ws0_f32");
+  Constraints    constraints("");
+  auto&          kernel_cache = get_kernel_cache();
+  auto&          cacher       = get_cacher();
+
+  std::unique_ptr<oclutil::CommandQueueInContext> tgcq;
+  std::unique_ptr<oclutil::DevInfo>               devinfo;
+  cl_command_queue                                queue = nullptr;
+  if (use_gpu)
+  {
+    tgcq.reset(new oclutil::CommandQueueInContext(silent, 0, {}, "hostbench"));
+    queue = tgcq->command_queue;
+    devinfo.reset(new oclutil::DevInfo(queue));
+  }
+  else
+  {
+    simdevice::SimParams simparams;
+    cacher.simdev =
+      std::make_shared<simdevice::Device>(simparams, simdevice::get_devinfo("gfx803"));
+    devinfo.reset(new oclutil::DevInfo(cacher.simdev->devinfo));
+  }
+
+  std::cout << gg.get_string() << " on " << (use_gpu ? devinfo->device_name : "simulated device")
+            << "\n\n"
+            << std::left << std::setw(26) << "stage [us]" << std::right << std::setw(12) << "min"
+            << std::setw(12) << "median" << std::setw(12) << "p90" << std::setw(12) << "mean"
+            << std::setw(12) << "stddev" << std::setw(8) << "n" << std::endl;
+
+  auto get_ID = [&cacher, &queue](const Geometry& x) {
+    return cacher.get_ID_from_geom(x, BetaType::IsOther, &queue);
+  };
+
+  // each miss is of a new geometry
+  size_t m_miss = gg.m;
+  report("ProgramCacher::get_ID miss",
+         get_samples(
+           [&gg, &get_ID, &m_miss]() {
+             get_ID(Geometry(++m_miss, gg.n, gg.k, false, false, 0, 'f'));
+           },
+           use_gpu ? 10 : 100,
+           false));
+
+  int ID = get_ID(gg);
+  report("ProgramCacher::get_ID hit", get_samples([&gg, &get_ID]() { get_ID(gg); }, 200, true));
+
+  report("get_default_soln",
+         get_samples(
+           [&devinfo, &gg, &constraints, &silent]() {
+             get_default_soln(*devinfo, gg, constraints, silent, IfNoCache::E::GENERIC, 0);
+           },
+           100,
+           true));
+
+  CacheKey ck(devinfo->identifier, constraints, gg);
+  Graph    graph(gg, *devinfo, constraints, silent);
+  report("nearest::get",
+         get_samples([&ck, &graph, &kernel_cache]() { nearest::get(ck, graph, kernel_cache, 0); },
+                     100,
+                     true));
+
+  report("Graph",
+         get_samples(
+           [&gg, &devinfo, &constraints, &silent]() { Graph(gg, *devinfo, constraints, silent); },
+           200,
+           true));
+
+  const HyPas& hp = cacher.hyper_params[ID];
+  report("DerivedParams", get_samples([&hp, &gg]() { DerivedParams(hp, gg); }, 200, true));
+
+  report("kerngen::Bundle", get_samples([&hp, &gg]() { kerngen::Bundle(hp, gg); }, 100, true));
+
+  // the arguments of the kernels, as in xgemm
+  const Programs&                 programs = cacher.program_cache[ID];
+  std::array<cl_mem, Mem::E::N>   gpu_mems{};
+  std::array<size_t, Mem::E::N>   offsets{};
+  std::vector<oclutil::SafeClMem> safemems(Mem::E::N, std::string("hostbench memory"));
+  if (use_gpu)
+  {
+    for (auto emem : {Mem::E::A, Mem::E::B, Mem::E::C, Mem::E::W})
+    {
+      size_t memsize =
+        emem == Mem::E::W
+          ? sizeof(float) * std::max<size_t>(1, get_total_workspace(gg, get_zero_offsets()))
+          : get_mat_memsize(gg, get_zero_offsets(), Mat::mem_to_mat(emem));
+      oclutil::cl_set_buffer_from_command_queue(
+        safemems[emem].clmem, queue, CL_MEM_READ_WRITE, memsize, nullptr, "hostbench", true);
+      gpu_mems[emem] = safemems[emem].clmem;
+    }
+  }
+
+  float       alpha = 1, beta = 1;
+  AllKernArgs all_kern_args;
+  report("get_arg_sizes_values",
+         get_samples(
+           [&programs, &gpu_mems, &offsets, &alpha, &beta, &all_kern_args]() {
+             all_kern_args.resize(0);
+             for (auto& index : programs.act_inds)
+             {
+               all_kern_args.emplace_back(kerngen::get_arg_sizes_values(
+                 programs.programs[index].kblob, gpu_mems, offsets, sizeof(float), &alpha, &beta));
+             }
+           },
+           200,
+           true));
+
+  // the kernels complete between samples
+  report(use_gpu ? "Programs::run" : "Programs::run (simulated)",
+         get_samples(
+           [&programs, &queue, &all_kern_args]() {
+             programs.run(queue, all_kern_args, 0, nullptr, nullptr, nullptr, false);
+           },
+           100,
+           !use_gpu,
+           [&queue, use_gpu]() {
+             if (use_gpu)
+             {
+               clFinish(queue);
+             }
+           }));
+
+  return 0;
+}
@@ -27,8 +27,13 @@ int main()
 
   auto&& kernel_cache = get_kernel_cache();
 
-  Halt          halt = {{{0, 5}}, {{0, 0.1}}};
-  auto          kcn  = get_merged(kernel_cache, kernel_cache2, halt, mowri);
+  Halt halt = {{{0, 5}}, {{0, 0.1}}};
+
+  // decided entries are journaled, so that re-running after an interruption resumes the merge
+  MergeParams mparms;
+  mparms.journal = "/home/james/test48/merge_journal.kc";
+
+  auto          kcn  = get_merged(kernel_cache, kernel_cache2, halt, mparms, mowri);
   std::ofstream floper("/home/james/test48/merged_cache48.txt", std::ios::out);
   for (auto& ck : kcn.get_keys())
   {
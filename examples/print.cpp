@@ -9,11 +9,11 @@ int main()
 {
   using namespace MIOpenGEMM;
   Geometry gg("tC0_tA1_tB0_colMaj1_m4096_n4096_k4096_lda4096_ldb4096_ldc4096_ws100000000_f32");
-  HyPas    hp{{{"MIC6_PAD1_PLU0_LIW0_MIW1_WOS2_VEW1",
-             "MIC8_PAD2_PLU0_LIW0_MIW1_WOS2_VEW2",
-             "UNR16_GAL3_PUN1_ICE1_IWI0_SZT0_NAW16_UFO0_MAC64_SKW10_AFI0_MIA0"}}};
+  HyPas    hp{{{"MIC6_PAD1_PLU0_LIW0_MIW1_WOS2_VEW1_SWZ0",
+             "MIC8_PAD2_PLU0_LIW0_MIW1_WOS2_VEW2_SWZ0",
+             "UNR16_GAL3_PUN1_ICE1_IWI0_SZT0_MAD0_NAW16_UFO0_MAC64_SKW10_AFI0_MIA0_DBL0_PFR0_STK0_FUS0"}}};
   owrite::Writer  mowri(Ver::E::TERMINAL, "");
-  kerngen::Bundle bundle(hp, gg);
+  kerngen::Bundle bundle(hp, gg, true);
 
   for (auto& x : bundle.v_tgks)
   {
@@ -0,0 +1,31 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <string>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/kernelcachefile.hpp>
+
+// Write the kernel cache (builtin, and site and user layers if set) to a binary kernel cache
+// file, which can be deployed as a site cache with MIOPENGEMM_SITE_CACHE.
+// Usage : writecachefile path/to/cachefile
+
+int main(int argc, char* argv[])
+{
+  using namespace MIOpenGEMM;
+
+  if (argc != 2)
+  {
+    std::cout << "Usage : writecachefile path/to/cachefile" << std::endl;
+    return 1;
+  }
+
+  std::string path = argv[1];
+  auto&&      kc   = get_kernel_cache();
+  cachefile::write(path, kc);
+
+  KernelCache reloaded;
+  auto        n_records = cachefile::load(path, reloaded);
+  std::cout << "wrote " << n_records << " entries to " << path << std::endl;
+  return 0;
+}
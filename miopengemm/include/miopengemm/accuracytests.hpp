@@ -25,6 +25,49 @@ void elementwise_compare(
   const TFloat*   c_cpu_abs,  // C matrix after GEMM : abs(alpha)*abs(A)abs(B) + abs(beta)*abs(C)
   std::string     info_str,   // to be printed in error message if there is a problem
   owrite::Writer& mowri);
+
+// The verifications below need neither a full CPU GEMM nor the abs GEMM. They use the same
+// test as elementwise_compare, abs(cpu - gpu) <= threshold * (abs(alpha)*abs(A)abs(B) +
+// abs(beta)*abs(C)), with the reference computed in double. Elements outside the matrix proper
+// of C (offset, tail and ldX padding) must be unchanged, as in elementwise_compare.
+
+const size_t default_n_samples     = 1000;
+const size_t default_n_projections = 4;
+
+// n_samples random elements of C are checked, each with an O(k) dot product. The 4 corners of C
+// are always checked, and if C has at most n_samples elements, all of them are.
+template <typename TFloat>
+void sampled_compare(const Geometry& gg,
+                     const Offsets&  toff,
+                     const TFloat*   a,
+                     const TFloat*   b,
+                     const TFloat*   c_before,  // C matrix before GEMM
+                     const TFloat*   c_gpu,     // C matrix after GEMM on GPU
+                     TFloat          alpha,
+                     TFloat          beta,
+                     size_t          n_samples,
+                     size_t          seed,
+                     std::string     info_str,
+                     owrite::Writer& mowri);
+
+// Freivalds' check : for n_projections random vectors x of +-1, C*x is compared against
+// alpha*A*(B*x) + beta*C_before*x, in O(mk + kn + mn). Each row of C*x is tested against the
+// sum of the bounds of its elements, so errors of many elements (a wrong tile, a race) are
+// caught, while a small error in a single element may be lost in the sum : that is what
+// sampled_compare is for.
+template <typename TFloat>
+void freivalds_compare(const Geometry& gg,
+                       const Offsets&  toff,
+                       const TFloat*   a,
+                       const TFloat*   b,
+                       const TFloat*   c_before,  // C matrix before GEMM
+                       const TFloat*   c_gpu,     // C matrix after GEMM on GPU
+                       TFloat          alpha,
+                       TFloat          beta,
+                       size_t          n_projections,
+                       size_t          seed,
+                       std::string     info_str,
+                       owrite::Writer& mowri);
 }
 }
 
@@ -5,6 +5,7 @@
 #define GUARD_MIOPENGEMM_BASEGENERATOR_HPP
 
 #include <miopengemm/derivedparams.hpp>
+#include <miopengemm/emitter.hpp>
 #include <miopengemm/geometry.hpp>
 #include <miopengemm/hyperparams.hpp>
 #include <miopengemm/kernelstring.hpp>
@@ -45,6 +46,7 @@ class BaseGenerator
 
   virtual size_t get_local_work_size() = 0;
   virtual size_t get_n_work_groups()   = 0;
+  size_t         get_global_work_size() { return get_n_work_groups() * get_local_work_size(); }
 
   private:
   virtual void set_type() = 0;
@@ -69,28 +71,31 @@ class BaseGenerator
     setup_final();
   }
 
-  virtual KernBlob get_kernelstring() = 0;
+  virtual void append_kernelstring(emit::Emitter& ss) = 0;
+
+  KernBlob get_kernelstring();
 
   virtual KType::E get_ktype() = 0;
 
   BaseGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_);
 
   // append argument(s) to the function definition
-  void append_farg(bool, std::stringstream&, const std::string&);
-
-  void append_fargs(std::stringstream& ss);
-
-  void append_unroll_block_geometry(Mat::E             emat_x,
-                                    std::stringstream& ss,
-                                    bool               withcomments,
-                                    bool               with_x_string);
-
-  void append_stride_definitions(Mat::E             emat_x,
-                                 std::stringstream& ss,
-                                 size_t             workspace_type,
-                                 bool               withcomments,
-                                 std::string        macro_prefix,
-                                 bool               append_stride_definitions);
+  void append_farg(bool, emit::Emitter&, const std::string&);
+
+  // first_farg (if not empty) precedes the arguments a, b, c, w, alpha and beta
+  void append_fargs(emit::Emitter& ss, const std::string& first_farg = "");
+
+  void append_unroll_block_geometry(Mat::E         emat_x,
+                                    emit::Emitter& ss,
+                                    bool           withcomments,
+                                    bool           with_x_string);
+
+  void append_stride_definitions(Mat::E         emat_x,
+                                 emit::Emitter& ss,
+                                 size_t         workspace_type,
+                                 bool           withcomments,
+                                 std::string    macro_prefix,
+                                 bool           append_stride_definitions);
 };
 }
 }
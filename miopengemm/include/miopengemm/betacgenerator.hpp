@@ -23,7 +23,7 @@ class BetacGenerator : public bylinegen::ByLineGenerator
 
   virtual void set_type() override final;
 
-  virtual void append_derived_definitions_additional(std::stringstream& ss) override final;
+  virtual void append_derived_definitions_additional(emit::Emitter& ss) override final;
 
   size_t get_local_work_size() override final;
 
@@ -32,7 +32,11 @@ class BetacGenerator : public bylinegen::ByLineGenerator
   virtual KType::E get_ktype() override final;
 };
 
-KernBlob get_betac_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+// with as_fused_function, the kernel string is a function of the fused kernel (see fusedgen)
+KernBlob get_betac_kernelstring(const HyPas&         hp,
+                                const Geometry&      gg,
+                                const DerivedParams& dp,
+                                bool                 as_fused_function = false);
 }
 }
 
@@ -36,7 +36,9 @@ class Bundle
   DerivedParams         dp;
   std::vector<KernBlob> v_tgks;
 
-  Bundle(const HyPas& hp, const Geometry& gg);
+  // indent : indent the kernel strings, for readability when printing them.
+  // Indenting does not change the compiled kernels, and is slower than generating them.
+  Bundle(const HyPas& hp, const Geometry& gg, bool indent = false);
 };
 }
 }
@@ -33,24 +33,24 @@ class ByLineGenerator : public prepgen::PrepGenerator
   ByLineGenerator(Mat::E emat_x, const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_);
   virtual ~ByLineGenerator() = default;
 
-  virtual KernBlob get_kernelstring() final override;
+  virtual void append_kernelstring(emit::Emitter& ss) final override;
   virtual void     setup_final() final override;
 
   private:
-  void append_description_string(std::stringstream& ss);
-  void append_how_definitions(std::stringstream& ss);
-  void append_copy_preprocessor(std::stringstream& ss);
-  void append_derived_definitions(std::stringstream& ss);
+  void append_description_string(emit::Emitter& ss);
+  void append_how_definitions(emit::Emitter& ss);
+  void append_copy_preprocessor(emit::Emitter& ss);
+  void append_derived_definitions(emit::Emitter& ss);
 
-  void append_setup_coordinates(std::stringstream& ss);
-  void append_positioning_x_string(std::stringstream& ss);
-  void append_inner_work(std::stringstream& ss);
-  void append_work_string(std::stringstream& ss);
-  void append_positioning_w_string(std::stringstream& ss);
+  void append_setup_coordinates(emit::Emitter& ss);
+  void append_positioning_x_string(emit::Emitter& ss);
+  void append_inner_work(emit::Emitter& ss);
+  void append_work_string(emit::Emitter& ss);
+  void append_positioning_w_string(emit::Emitter& ss);
 
   protected:
   virtual void setup_additional()                                           = 0;
-  virtual void append_derived_definitions_additional(std::stringstream& ss) = 0;
+  virtual void append_derived_definitions_additional(emit::Emitter& ss) = 0;
 };
 }
 }
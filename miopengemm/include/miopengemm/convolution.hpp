@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_CONVOLUTION_HPP
+#define GUARD_MIOPENGEMM_CONVOLUTION_HPP
+
+#include <string>
+
+namespace MIOpenGEMM
+{
+
+/*! @brief
+ * A 2-D convolution of one image, for implicit GEMM : B is the im2col matrix of the image,
+ * which is never materialised. Element (kk, nn) of B, where kk = (ci*r + ri)*s + si and
+ * nn = hj*get_out_w() + wj, is element (ci, hi, wi) of the image, where
+ * hi = hj*stride_h + ri*dilation_h - pad_h and wi = wj*stride_w + si*dilation_w - pad_w,
+ * or 0 if (hi, wi) is in the padding. So k = c*r*s and n = get_out_h()*get_out_w(). */
+class Convolution
+{
+  public:
+  /*! layout of the image, NCHW (false) or NHWC (true). N is 1, one GEMM per image */
+  bool nhwc = false;
+  /*! channels, height and width of the image */
+  size_t c = 0;
+  size_t h = 0;
+  size_t w = 0;
+  /*! height and width of the filters */
+  size_t r = 0;
+  size_t s = 0;
+  size_t pad_h      = 0;
+  size_t pad_w      = 0;
+  size_t stride_h   = 1;
+  size_t stride_w   = 1;
+  size_t dilation_h = 1;
+  size_t dilation_w = 1;
+
+  Convolution(bool   nhwc,
+              size_t c,
+              size_t h,
+              size_t w,
+              size_t r,
+              size_t s,
+              size_t pad_h,
+              size_t pad_w,
+              size_t stride_h,
+              size_t stride_w,
+              size_t dilation_h,
+              size_t dilation_w);
+
+  /*! @brief
+   * no convolution : B is an ordinary matrix */
+  Convolution() = default;
+
+  bool is_set() const { return c != 0; }
+
+  /*! height and width of the output */
+  size_t get_out_h() const;
+  size_t get_out_w() const;
+
+  /*! the dimensions of the im2col matrix, k and n of the GEMM */
+  size_t get_k() const { return c * r * s; }
+  size_t get_n() const { return get_out_h() * get_out_w(); }
+
+  /*! number of values in the image */
+  size_t get_image_size() const { return c * h * w; }
+
+  /*! @brief
+   * the index in the image of element (kk, nn) of the im2col matrix. Returns false if it is in
+   * the padding, in which case the element is 0 */
+  bool get_image_index(size_t kk, size_t nn, size_t& index) const;
+
+  std::string get_string() const;
+
+  bool operator==(const Convolution&) const;
+};
+}
+
+#endif
@@ -23,15 +23,19 @@ class CopyGenerator : public bylinegen::ByLineGenerator
 
   virtual KType::E get_ktype() override final;
 
-  virtual void append_derived_definitions_additional(std::stringstream& ss) override final;
+  virtual void append_derived_definitions_additional(emit::Emitter& ss) override final;
 
   size_t get_local_work_size() override final;
 
   size_t get_work_per_thread() override final;
 };
 
-KernBlob
-get_copy_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+// with as_fused_function, the kernel string is a function of the fused kernel (see fusedgen)
+KernBlob get_copy_kernelstring(Mat::E               emat_x,
+                               const HyPas&         hp,
+                               const Geometry&      gg,
+                               const DerivedParams& dp,
+                               bool                 as_fused_function = false);
 }
 }
 
@@ -14,6 +14,8 @@ namespace MIOpenGEMM
 namespace cpugemm
 {
 
+// C <- alpha*A*B + beta*C, with OpenBLAS if MIOPENGEMM_USE_OPENBLAS is defined, otherwise with
+// a cache blocked, vectorised and multithreaded implementation. C is overwritten if beta is 0.
 template <typename TFloat>
 void gemm(Geometry        gg,
           Offsets         toff,
@@ -23,6 +25,30 @@ void gemm(Geometry        gg,
           TFloat          alpha,
           TFloat          beta,
           owrite::Writer& mowri);
+
+// As gemm, and in the same pass c_abs <- abs(alpha)*abs(A)abs(B) + abs(beta)*abs(C), the bound
+// used in accuracy tests. c_abs has the size of c, and outside the matrix proper is unspecified.
+template <typename TFloat>
+void gemm_with_abs(Geometry        gg,
+                   Offsets         toff,
+                   const TFloat*   a,
+                   const TFloat*   b,
+                   TFloat*         c,
+                   TFloat*         c_abs,
+                   TFloat          alpha,
+                   TFloat          beta,
+                   owrite::Writer& mowri);
+
+// As gemm, with the naive triple loop. It is slow, and kept as a reference to benchmark against.
+template <typename TFloat>
+void gemm_3fors(Geometry        gg,
+                Offsets         toff,
+                const TFloat*   a,
+                const TFloat*   b,
+                TFloat*         c,
+                TFloat          alpha,
+                TFloat          beta,
+                owrite::Writer& mowri);
 }
 }
 
@@ -28,6 +28,19 @@ class Derivabilty
 
 bool is_dvble(const HyPas&, const Geometry&);
 
+// The preparation kernels fused into one PREP kernel (see NonChi::E::FUS) : the workspace
+// kernels of A and B (ws), and the beta scaling of C with them (betac). As fusing fewer than
+// 2 kernels gains nothing, ws is false then. Used by the Bundle, and by the Graph to skip FUS
+// where it has no effect.
+class PrepFusion
+{
+  public:
+  bool ws    = false;
+  bool betac = false;
+};
+
+PrepFusion get_prep_fusion(const HyPas&);
+
 class ChiralDerivedParams
 {
   public:
@@ -48,6 +61,9 @@ class ChiralDerivedParams
   // used when loading LDS -> registers, depends on MIW
   size_t main_c_interweave_stride;
 
+  // (if SWZ is YES) the column of LDS, in vectors, is XORed with (row & main_lds_swizzle_mask)
+  size_t main_lds_swizzle_mask = uninitialised_size_t;
+
   // copy to workspace specific parameters
   size_t cw_global_offset = uninitialised_size_t;
   size_t cw_n_elements    = uninitialised_size_t;
@@ -114,6 +130,19 @@ class DerivedParams
   size_t main_does_beta_c_inc         = uninitialised_size_t;
   size_t main_use_edge_trick          = uninitialised_size_t;
   size_t main_final_fractional_unroll = uninitialised_size_t;
+  // 2 if the LDS is double buffered (DBL), otherwise 1
+  size_t main_n_lds_buffers = uninitialised_size_t;
+  // registers per work item holding the prefetched unroll (PFR), 0 without prefetching
+  size_t main_n_prefetch_registers = uninitialised_size_t;
+  // 1 if STK work groups share the (tile, unroll) work units, see NonChi::E::STK
+  size_t main_stream_k = uninitialised_size_t;
+  // the number of (macro tile, unroll) work units with stream-K, otherwise 0
+  size_t main_n_stream_k_units = uninitialised_size_t;
+  // C is written with vectors of main_c_vector_width elements, contiguous along the coalesced
+  // dimension of C (that of main_c_vector_emat). 1 unless there are no atomics, the VEW of
+  // main_c_vector_emat divides ldc and its edge tile is not shifted.
+  size_t main_c_vector_width = uninitialised_size_t;
+  Mat::E main_c_vector_emat  = Mat::E::N;
 
   // specific to scaling kernel, betac
   size_t betac_local_work_size = uninitialised_size_t;
@@ -141,6 +170,10 @@ class DerivedParams
   size_t ga3_super_column_width      = uninitialised_size_t;
   size_t ga3_last_super_column_width = uninitialised_size_t;
 
+  // GA 4 and 5 (space filling curves) : the curve covers square blocks of sfc_block_width
+  // work groups, a power of 2. Work groups not in a full block are allocated column-by-column
+  size_t sfc_block_width = uninitialised_size_t;
+
   // Total required workspace
   size_t required_workspace = uninitialised_size_t;
 
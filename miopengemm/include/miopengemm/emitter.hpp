@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_EMITTER_HPP
+#define GUARD_MIOPENGEMM_EMITTER_HPP
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace MIOpenGEMM
+{
+namespace emit
+{
+
+// Used in place of std::stringstream by the kernel string generators : text is appended to a
+// preallocated buffer, and integers are formatted directly, without locales or stream state.
+class Emitter
+{
+  private:
+  std::string text;
+
+  void put_integer(bool negative, unsigned long long magnitude);
+
+  public:
+  Emitter();
+
+  Emitter& operator<<(const std::string& s)
+  {
+    text.append(s);
+    return *this;
+  }
+
+  Emitter& operator<<(const char* s)
+  {
+    text.append(s, std::strlen(s));
+    return *this;
+  }
+
+  Emitter& operator<<(char c)
+  {
+    text.push_back(c);
+    return *this;
+  }
+
+  // as with std::stringstream, bools are written as 0 and 1
+  template <typename T, typename std::enable_if<std::is_integral<T>::value>::type* = nullptr>
+  Emitter& operator<<(T x)
+  {
+    bool negative = x < static_cast<T>(0);
+    put_integer(negative,
+                negative ? 0ull - static_cast<unsigned long long>(x)
+                         : static_cast<unsigned long long>(x));
+    return *this;
+  }
+
+  const std::string& str() const { return text; }
+
+  // the text, leaving the Emitter empty
+  std::string release();
+};
+}
+}
+
+#endif
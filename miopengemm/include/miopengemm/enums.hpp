@@ -82,6 +82,7 @@ enum E
   MIW,
   WOS,
   VEW,  // vector width
+  SWZ,  // XOR swizzle the LDS columns by row, avoiding bank conflicts without padding
   N
 };
 const EnumMapper<std::string>& M();
@@ -107,6 +108,10 @@ enum E
   SKW,      // skewness of work-item grid of work group
   AFI,      // do A loops and defs first. outerloops over a dimensions.
   MIA,      // work item allocation within workgroup : % or /
+  DBL,      // double buffer LDS : load the next unroll into LDS while computing the current
+  PFR,      // prefetch the next unroll from global memory into registers while computing the current
+  STK,      // (if not 0) number of persistent work groups sharing (tile, unroll) units : stream-K
+  FUS,      // fuse preparation kernels : 1 for WSA and WSB in one launch, 2 for BETAC as well
   N
 };
 const EnumMapper<std::string>& M();
@@ -178,9 +183,11 @@ namespace GroupAllocation
 {
 enum E
 {
-  BYROW = 1,
-  BYCOL = 2,
-  SUCOL = 3
+  BYROW   = 1,
+  BYCOL   = 2,
+  SUCOL   = 3,
+  MORTON  = 4,  // Z-order curve within square blocks of work groups
+  HILBERT = 5   // Hilbert curve within square blocks of work groups
 };
 }
 
@@ -195,6 +202,19 @@ enum E
 const EnumMapper<std::string>& M();
 }
 
+// How the result of a GEMM is verified against the CPU, see accuracytests.hpp
+namespace Verification
+{
+enum E
+{
+  FULL = 0,   // all of C, against a full CPU GEMM
+  SAMPLED,    // a random sample of the elements of C, each with a dot product
+  FREIVALDS,  // random projections, C*x against alpha*A*(B*x) + beta*C*x
+  N
+};
+const EnumMapper<std::string>& M();
+}
+
 namespace Scratch
 {
 enum E
@@ -253,7 +273,8 @@ enum E
   WSB,
   BETAC,
   MAIN,
-  N  // how many KTypes
+  PREP,  // several of WSA, WSB and BETAC fused in one kernel (see NonChi::E::FUS)
+  N      // how many KTypes
 };
 const EnumMapper<std::string>& M();
 
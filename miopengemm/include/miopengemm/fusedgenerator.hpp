@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_FUSEDGENERATOR_HPP
+#define GUARD_MIOPENGEMM_FUSEDGENERATOR_HPP
+
+#include <vector>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/kernelstring.hpp>
+
+namespace MIOpenGEMM
+{
+namespace fusedgen
+{
+
+// One kernel (KType::E::PREP) running the preparation kernels of parts, which are generated
+// with as_fused_function. The work groups are allocated to the parts in order, each part
+// getting as many as it would have been launched with. The work group size is the largest of
+// the parts, the work items beyond the size of a part are idle.
+KernBlob get_fused_kernelstring(const std::vector<KernBlob>& parts,
+                                const HyPas&                 hp,
+                                const Geometry&              gg,
+                                const DerivedParams&         dp);
+}
+}
+
+#endif
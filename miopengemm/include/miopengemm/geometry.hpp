@@ -6,6 +6,7 @@
 
 #include <string>
 #include <vector>
+#include <miopengemm/convolution.hpp>
 #include <miopengemm/enums.hpp>
 
 // TODO : namespace should be lower-case
@@ -90,6 +91,12 @@ class Geometry
    *  or 'd' (64-bit double precision). */
   char floattype;
 
+  /*! if set, B is the im2col matrix of an image, computed on the fly (implicit GEMM). The
+   *  memory of B is then the image, and ldb is the leading dimension of the virtual B.
+   *  Kernel cache entries with a convolution can be in the site and user cache files (see
+   *  kernelcachefile.hpp), but not in the builtin .cachetxt files (see python/cachetables.py) */
+  Convolution conv;
+
   public:
   GeometryDerived derived;
 
@@ -142,6 +149,10 @@ class Geometry
 
   void check_ldx_consistent() const;
 
+  /*! @brief
+   * with a convolution, B must be the k x n im2col matrix, column major with ldb = k */
+  void check_conv_consistent() const;
+
   size_t get_padded_area(Mat::E M) const;
 
   /*! @brief
@@ -150,6 +161,10 @@ class Geometry
 
   double get_distance(const Geometry& g2) const;
 
+  // the L1 distance between these is a lower bound on get_distance (up to the
+  // workspace term, of magnitude < 1e-3), when transposes are the same.
+  const std::array<double, 6>& get_metric_co() const { return metric_co; }
+
   bool same_transposes(const Geometry& g2) const;
 };
 
@@ -208,6 +223,31 @@ Geometry get_squareNN_geometry(size_t m)
   return get_geometry_from_padding<TFloat>(true, false, false, false, m, m, m, 0, 0, 0, 0);
 }
 
+/*! @brief
+ * The geometry of an implicit GEMM convolution : C (m x n, leading dimension ldc) is the output
+ * of m filters, A (m x k, leading dimension lda) holds the filters, with the values of each filter
+ * contiguous if tA is true, and B is the im2col matrix of the image, never materialised. */
+template <typename TFloat>
+Geometry get_implicit_conv_geometry(
+  bool tA, size_t lda, size_t ldc, size_t m, const Convolution& conv, size_t wSpaceSize)
+{
+  Geometry gg(true,
+              tA,
+              false,
+              false,
+              lda,
+              conv.get_k(),
+              ldc,
+              m,
+              conv.get_n(),
+              conv.get_k(),
+              wSpaceSize,
+              get_floattype_char<TFloat>());
+  gg.conv = conv;
+  gg.check_conv_consistent();
+  return gg;
+}
+
 size_t get_mat_size(const Geometry& gg, const Offsets& toff, Mat::E emat);
 size_t get_mat_memsize(const Geometry& gg, const Offsets& toff, Mat::E emat);
 size_t get_total_workspace(const Geometry& gg, const Offsets& toff);
@@ -18,6 +18,10 @@ namespace MIOpenGEMM
 
 std::string get_location_string(Mat::E emat, size_t hpi);
 
+// Seed the random starts and neighbor shuffles of all Graphs, randomly seeded by default.
+// With a fixed seed and a noiseless simulated device, find is reproducible.
+void set_random_seed(int seed);
+
 class SuGr
 {
   private:
@@ -5,6 +5,8 @@
 #define GUARD_MIOPENGEMM_KERNELCACHE_HPP
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <miopengemm/derivedparams.hpp>
 
@@ -49,19 +51,39 @@ class CacheKeyHash
   size_t operator()(const CacheKey& ck) const;
 };
 
+using CacheMap = std::unordered_map<CacheKey, HyPas, CacheKeyHash>;
+
+namespace nearest
+{
+class Index;
+}
+
 class KernelCache
 {
   private:
-  std::unordered_map<CacheKey, HyPas, CacheKeyHash> vals;
+  CacheMap vals;
+
+  // for nearest neighbor queries, built on first use and reset when entries change
+  mutable std::shared_ptr<const nearest::Index> index;
+  mutable std::shared_ptr<std::mutex>           index_mutex = std::make_shared<std::mutex>();
 
   public:
+  KernelCache() = default;
+  // the index refers to entries of vals, so is not copied
+  KernelCache(const KernelCache&);
+  KernelCache& operator=(const KernelCache&);
+
   CacheKeyPresence check_for(const CacheKey& ck) const;
+  bool contains(const CacheKey& ck) const { return vals.count(ck) != 0; }
   HyPas at(const CacheKey& ck, bool swap_ab) const;
   const HyPas& at(const CacheKey& ck) const;
 
   // hp must be transformed if geometry is.
   void add(const CacheKey& ckey, const HyPas& hp);
+  // as add, but replacing an existing entry (for overlaying caches)
+  void set(const CacheKey& ckey, const HyPas& hp);
   std::vector<CacheKey> get_keys() const;
+  std::shared_ptr<const nearest::Index> get_index() const;
 
   std::string get_cache_entry_string(const CacheKey& ck) const;
 };
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_KERNELCACHEFILE_HPP
+#define GUARD_MIOPENGEMM_KERNELCACHEFILE_HPP
+
+#include <string>
+#include <miopengemm/kernelcache.hpp>
+
+// Binary kernel cache files, loaded at run time on top of the compiled-in (builtin) cache.
+// The layers, each overriding entries of the previous, are
+// (1) builtin : the .cachetxt files compiled into the library
+// (2) site    : the file at $MIOPENGEMM_SITE_CACHE, if set
+// (3) user    : the file at $MIOPENGEMM_USER_CACHE, if set. find appends new entries here.
+//
+// File format (native byte order) :
+// header : 8 bytes, "MIOGKC" followed by the 2 byte format version.
+// records, each : u32 payload size, u32 FNV-1a checksum of payload, payload.
+// payload : u8 flags (isColMajor, tA, tB, tC, has convolution in bits 0-4), u8 floattype,
+//           u16 unused, u64 m, n, k, lda, ldb, ldc, wSpaceSize,
+//           if it has a convolution, u64 nhwc, c, h, w, r, s, pad_h, pad_w, stride_h, stride_w,
+//           dilation_h, dilation_w,
+//           then the strings device, constraints, hp A, hp B, hp C, each as u16 size + chars.
+// Records are appended and never modified in place, later records override earlier ones.
+// A file of another format version is ignored, and corrupt or invalid records are skipped, each
+// with a warning on std::cerr : a bad file never stops the library from working.
+
+namespace MIOpenGEMM
+{
+namespace cachefile
+{
+
+// empty if the environment variable is not set
+std::string get_site_path();
+std::string get_user_path();
+
+// Add all entries in the file at path to kc, overriding existing entries with the same key.
+// The file is memory mapped (read, on Windows). Returns the number of records read, 0 if there
+// is no (usable) file.
+size_t load(const std::string& path, KernelCache& kc);
+
+// Append one entry to the file at path, creating it if necessary. The record is written with
+// a single write under an exclusive lock, so concurrent appends (from several processes)
+// do not interleave (on Windows, appends are not locked). hp should correspond to the
+// (canonical) geometry of ck.
+void append(const std::string& path, const CacheKey& ck, const HyPas& hp);
+
+// Write all entries of kc to the file at path, replacing it atomically (rename).
+void write(const std::string& path, const KernelCache& kc);
+}
+}
+
+#endif
@@ -4,14 +4,92 @@
 #ifndef GUARD_MIOPENGEMM_KERNELCACHEMERGE_HPP
 #define GUARD_MIOPENGEMM_KERNELCACHEMERGE_HPP
 
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
 #include <miopengemm/findparams.hpp>
+#include <miopengemm/hint.hpp>
 #include <miopengemm/kernelcache.hpp>
+#include <miopengemm/simdevice.hpp>
 
 namespace MIOpenGEMM
 {
+
+class MergeParams
+{
+  public:
+  // One worker per device. Cache keys in dispute are shared out between the workers, each of
+  // which compiles the contenders of its next key while benchmarking its current key.
+  // Workers on the same device (the same hint repeated) contend for it, and time less reliably.
+  std::vector<CLHint> hints{CLHint()};
+
+  // If not empty, the workers run on these simulated devices and hints is ignored.
+  std::vector<std::shared_ptr<simdevice::Device>> simdevs{};
+
+  // If not empty, each decided entry is appended to this kernel cache file (kernelcachefile.hpp).
+  // Entries already in it are not re-determined, so an interrupted merge can be resumed.
+  std::string journal{""};
+
+  // maximum number of rounds per key (each remaining contender runs once per round),
+  size_t max_rounds = 14;
+  // eliminating a contender when another has beaten it in this many more rounds than it lost.
+  size_t margin = 5;
+  // seconds to pause before each run, 0 for no pause.
+  double pause = 0;
+};
+
+// The outcome of the tournament for one cache key
+class MergeRecord
+{
+  public:
+  CacheKey ck;
+  // per cache, the median GFlops of its solution, 0 if the cache has no entry for ck
+  std::vector<double> gflops;
+  // a cache whose solution won
+  size_t winner;
+  // the cache with the best of the other solutions
+  size_t runner_up;
+  size_t rounds;
+  // two-sided sign test p-value, of winner against runner_up in the rounds both ran
+  double p_value;
+  // 95% confidence interval of the speed-up of winner over runner_up (geometric mean)
+  std::array<double, 2> speedup_ci;
+
+  // the gain of the winning solution over the solution of cache ci (0.1 for 10%)
+  double get_gain(size_t ci) const;
+};
+
+class MergeReport
+{
+  public:
+  size_t                   n_caches{0};
+  std::vector<MergeRecord> records{};
+
+  // a line per geometry, then per cache the number of wins and the mean gain of the merge
+  std::string get_string() const;
+};
+
 KernelCache
 get_merged(const KernelCache& kc1, const KernelCache& kc2, const Halt& halt, owrite::Writer& mowri);
 
+KernelCache get_merged(const KernelCache& kc1,
+                       const KernelCache& kc2,
+                       const Halt&        halt,
+                       const MergeParams& mparms,
+                       owrite::Writer&    mowri);
+
+// N-way merge. Where the caches have different solutions for a key, all distinct solutions
+// run in rounds, in the order of the generalised Thue–Morse sequence (rotated by the base-N
+// digit sum of the round), so that no solution is favoured by running first. Clearly
+// dominated solutions (see MergeParams::margin) are eliminated early, and the winner is the
+// remaining solution with the most head-to-head wins (then, fastest median).
+KernelCache get_merged(const std::vector<const KernelCache*>& kcs,
+                       const Halt&                            halt,
+                       const MergeParams&                     mparms,
+                       owrite::Writer&                        mowri,
+                       MergeReport&                           report);
+
 KernelCache get_wSpaceReduced(const KernelCache& kc);
 }
 
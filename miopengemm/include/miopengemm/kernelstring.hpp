@@ -5,6 +5,7 @@
 #define GUARD_MIOPENGEMM_KERNELSTRINGS_HPP
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <miopengemm/enums.hpp>
 
@@ -51,7 +52,7 @@ class KernBlob
            size_t             local_work_size_)
     : e_ktype(e_ktype_),
       kuses(kuses_),
-      kernstr(kernstr_),
+      kernstr(std::move(kernstr_)),
       fname(fname_),
       global_work_size(global_work_size_),
       local_work_size(local_work_size_)
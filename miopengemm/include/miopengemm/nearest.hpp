@@ -4,6 +4,8 @@
 #ifndef GUARD_MIOPENGEMM_NEAREST_HPP
 #define GUARD_MIOPENGEMM_NEAREST_HPP
 
+#include <array>
+#include <vector>
 #include <miopengemm/graph.hpp>
 #include <miopengemm/kernelcache.hpp>
 
@@ -12,6 +14,37 @@ namespace MIOpenGEMM
 namespace nearest
 {
 
+// A node of a vantage-point tree over Geometry::get_metric_co, with the L1 distance.
+// The tree is stored implicitly : the subtree of the node at position lo covers [lo, hi),
+// those within mu of it are in [lo + 1, mid) and the rest in [mid, hi).
+class IndexEntry
+{
+  public:
+  const CacheKey*       ck;
+  const HyPas*          hp;
+  std::array<double, 6> co;
+  double                mu;
+  size_t                mid;
+  size_t                hi;
+};
+
+// The CacheKeys with the same device, transposes and float type.
+class IndexBucket
+{
+  public:
+  const Geometry*         gg;
+  std::string             dvc;
+  std::vector<IndexEntry> entries;
+};
+
+// Index of a KernelCache for nearest neighbor queries, see KernelCache::get_index.
+class Index
+{
+  public:
+  std::vector<IndexBucket> buckets;
+  Index(const CacheMap&);
+};
+
 // for all CacheKeys, ck, in the KernelCache, which have
 // (1) at(ck) with ck_in.gg is derivable.
 // (2) at(ck) is in graph,
@@ -20,6 +53,7 @@ bool is_within(
   const CacheKey& ck_in, const Graph&, const KernelCache&, double threshold, size_t rank);
 
 // of all the CacheKeys in the KernelCache, return the {rank} nearest satisfying (1) and (2) above.
+// If ck_in itself is in the KernelCache and satisfies (1) and (2), it is the rank 0 nearest.
 CacheKey get(const CacheKey&, const Graph&, const KernelCache&, size_t rank);
 }
 }
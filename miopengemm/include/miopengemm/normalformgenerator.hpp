@@ -14,8 +14,12 @@ namespace MIOpenGEMM
 namespace nformgen
 {
 
-KernBlob
-get_nform_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+// with as_fused_function, the kernel string is a function of the fused kernel (see fusedgen)
+KernBlob get_nform_kernelstring(Mat::E               emat_x,
+                                const HyPas&         hp,
+                                const Geometry&      gg,
+                                const DerivedParams& dp,
+                                bool                 as_fused_function = false);
 }
 }
 
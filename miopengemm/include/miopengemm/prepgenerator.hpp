@@ -21,18 +21,22 @@ class PrepGenerator : public basegen::BaseGenerator
   char   MCHAR;
   char   mchar;
 
+  // if true, the kernel is emitted as a function of the fused preparation kernel (see
+  // fusedgen), which passes the id of the work group as the first argument
+  bool as_fused_function = false;
+
   virtual void set_usage() override final;
-  void append_basic_what_definitions(std::stringstream& ss);
+  void append_basic_what_definitions(emit::Emitter& ss);
 
-  size_t get_global_work_size()
-  {
-    size_t forall_global_work_size = get_n_work_groups() * get_local_work_size();
-    return forall_global_work_size;
-  }
+  // the kernel (or function) declaration, including the arguments
+  void append_declaration(emit::Emitter& ss);
+  std::string get_group_id_string();
 
   public:
   virtual ~PrepGenerator() = default;
   PrepGenerator(Mat::E emat_x, const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_);
+
+  void set_as_fused_function() { as_fused_function = true; }
 };
 }
 }
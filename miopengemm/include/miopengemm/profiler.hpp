@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_PROFILER_HPP
+#define GUARD_MIOPENGEMM_PROFILER_HPP
+
+#include <array>
+#include <limits>
+#include <map>
+#include <string>
+#include <miopengemm/enums.hpp>
+#include <miopengemm/platform.hpp>
+
+// Opt-in profiling of xgemm in production. One in N calls of xgemm is sampled, and the times of
+// its kernels are read from their cl_events in callbacks, when they complete : xgemm never blocks.
+// Times are aggregated in histograms, one per (ID, KType), where ID is that of xgemm's GemmStatus.
+// The command queue passed to xgemm must have CL_QUEUE_PROFILING_ENABLE, otherwise the times of
+// sampled kernels are not available, and are only counted (see Counts).
+namespace MIOpenGEMM
+{
+namespace profiler
+{
+
+// A histogram of times [us], with logarithmic buckets : bucket b holds times in
+// [get_edge(b), get_edge(b + 1)), the first bucket also holds times below 1 us, and the last
+// also holds times above get_edge(n_buckets) (about 16 s).
+class Histogram
+{
+  public:
+  constexpr static size_t buckets_per_octave = 4;
+  constexpr static size_t n_octaves          = 24;
+  constexpr static size_t n_buckets          = buckets_per_octave * n_octaves;
+
+  std::array<size_t, n_buckets> counts{};
+  size_t                        n     = 0;
+  double                        total = 0;
+  double                        min   = std::numeric_limits<double>::max();
+  double                        max   = 0;
+
+  void add(double t);
+
+  static double get_edge(size_t b);
+  double        get_mean() const;
+  // an estimate of the p-th quantile (0 <= p <= 1), to within a bucket's width (19%)
+  double get_percentile(double p) const;
+};
+
+class Profile
+{
+  public:
+  // Geometry::get_string() of the ID
+  std::string geometry;
+  // the number of sampled calls
+  size_t                             n_calls = 0;
+  std::array<Histogram, KType::E::N> histograms;
+  // the total time [us] of all kernels
+  double get_total() const;
+};
+
+class Counts
+{
+  public:
+  // events whose times are still to be read
+  size_t n_pending;
+  // events whose times were not available (no CL_QUEUE_PROFILING_ENABLE)
+  size_t n_unavailable;
+  // events which terminated abnormally, or on which a callback could not be set
+  size_t n_failed;
+};
+
+// Sample one in n calls of xgemm, or none if n is 0. The default is $MIOPENGEMM_PROFILE if set,
+// otherwise 0. Changing n does not clear the profiles.
+void   set_sampling(size_t n);
+size_t get_sampling();
+
+// Should this call of xgemm be sampled? A load of an atomic when profiling is disabled.
+bool sample();
+
+// Count a sampled call of ID.
+void add_call(int ID, const std::string& geometry);
+
+// Add the time of the kernel of event to the histogram (ID, ktype) when the event completes. The
+// event is retained until then, so the caller may release it.
+void record(int ID, KType::E ktype, cl_event event);
+
+// Add a time [us] now, for kernels not run with OpenCL (see simdevice.hpp).
+void record_time(int ID, KType::E ktype, double t);
+
+// Copies of the profiles, by ID. Times of events pending are not included : to include all
+// sampled kernels enqueued, finish their command queues and wait for get_counts().n_pending == 0.
+std::map<int, Profile> get_profiles();
+Counts                 get_counts();
+
+// Clear the profiles and counts (but not the counts of pending events).
+void reset();
+
+// The geometries sorted by total time, with the time percentiles of each of their kernels.
+std::string get_report();
+}
+}
+
+#endif
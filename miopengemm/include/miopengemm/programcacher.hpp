@@ -16,6 +16,7 @@
 #include <miopengemm/outputwriter.hpp>
 #include <miopengemm/platform.hpp>
 #include <miopengemm/programs.hpp>
+#include <miopengemm/simdevice.hpp>
 
 namespace MIOpenGEMM
 {
@@ -48,6 +49,11 @@ class ProgramCacher
   std::unordered_map<std::string, int> IDs;
   std::mutex mutt;
 
+  // if not nullptr, the device of the command queue passed to get_ID is ignored, and programs
+  // are compiled and run on this simulated device (see simdevice.hpp) : get_ID, and the host
+  // side of xgemm, can then be run and benchmarked without a GPU.
+  std::shared_ptr<simdevice::Device> simdev;
+
   int get_ID(bool              isColMajor,
              bool              tA,
              bool              tB,
@@ -13,26 +13,15 @@
 #include <miopengemm/oclutil.hpp>
 #include <miopengemm/outputwriter.hpp>
 #include <miopengemm/platform.hpp>
+#include <miopengemm/programstore.hpp>
+#include <miopengemm/simdevice.hpp>
+#include <miopengemm/tracer.hpp>
 
 namespace MIOpenGEMM
 {
 
 using AllKernArgs = std::vector<std::vector<std::pair<size_t, const void*>>>;
 
-class SafeCLProgram
-{
-  public:
-  cl_program clprog = nullptr;
-
-  ~SafeCLProgram()
-  {
-    if (clprog)
-    {
-      oclutil::cl_release_program(clprog, "~Program", true);
-    }
-  }
-};
-
 class KernelTime
 {
   public:
@@ -59,10 +48,13 @@ class Program
   cl_context   context;
   KernBlob     kblob;
 
+  // shared with all Programs with the same kernel (see programstore.hpp)
   std::shared_ptr<SafeCLProgram> sclp;
   Program(cl_device_id, cl_context);
   Program() : Program(nullptr, nullptr) {}
   oclutil::Result update(const KernBlob&, owrite::Writer&, const std::string& build_options);
+  // as update, but no OpenCL : compilation is replaced by sleeping for compile_delay [s]
+  oclutil::Result update_simulated(const KernBlob&, owrite::Writer&, double compile_delay);
 };
 
 class Programs
@@ -74,6 +66,14 @@ class Programs
   std::vector<std::vector<size_t>> v_wait_indices;
   owrite::Writer*                  ptr_mowri;
 
+  // if not nullptr, kernels are compiled and run on this simulated device (see simdevice.hpp)
+  std::shared_ptr<simdevice::Device> simdev;
+  // modelled times [ms] of the kernels on simdev, set when updating from a Bundle
+  std::array<double, KType::E::N> sim_times{};
+
+  // if not nullptr, compilations are recorded here (see tracer.hpp)
+  std::shared_ptr<trace::Tracer> tracer;
+
   // This function will
   // (1) create a vector of cl_kernels from programs indexed by act_inds.
   // (2) create a vector of cl_events for each kernel except the last one.
@@ -82,13 +82,19 @@ class Programs
   //     (3.2) set the arguments of the k
   //     (3.3) enqueue k
   // (4) if update_times, update program times (use act_inds).
+  // (5) if profile_ID is not negative, record the times of the kernels (see profiler.hpp).
   oclutil::Result run(const cl_command_queue&,
                       const AllKernArgs&,
                       cl_uint         n_user_wait_list,
                       const cl_event* user_wait_list,
                       KernelTimes*    ptr_ktimes,
                       cl_event*       ptr_user_event,
-                      bool            debug_mode) const;
+                      bool            debug_mode,
+                      int             profile_ID = -1) const;
+
+  // As run, but on simdev : the command queue and kernel arguments are ignored,
+  // and ktimes are sampled from the modelled times.
+  oclutil::Result run_simulated(KernelTimes* ptr_ktimes, int profile_ID = -1) const;
 
   // This function will update
   // (1) act_inds
@@ -96,8 +102,13 @@ class Programs
   // (3) v_wait_indices
   oclutil::Result update(const std::vector<KernBlob>&);
 
+  // As above, and if simulated, (4) sim_times.
+  oclutil::Result update(const kerngen::Bundle&);
+
   size_t get_n_active() const { return act_inds.size(); }
+  bool   is_simulated() const { return simdev != nullptr; }
   Programs(const cl_device_id&, const cl_context&, owrite::Writer& mowri_);
+  Programs(std::shared_ptr<simdevice::Device>, owrite::Writer& mowri_);
 
   Programs() = default;
 
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_PROGRAMSTORE_HPP
+#define GUARD_MIOPENGEMM_PROGRAMSTORE_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <miopengemm/oclutil.hpp>
+#include <miopengemm/outputwriter.hpp>
+
+namespace MIOpenGEMM
+{
+
+class SafeCLProgram
+{
+  public:
+  cl_program clprog = nullptr;
+
+  ~SafeCLProgram()
+  {
+    if (clprog)
+    {
+      oclutil::cl_release_program(clprog, "~Program", true);
+    }
+  }
+};
+
+namespace programstore
+{
+
+// The kernel string without comments, indentation and blank lines. Kernel strings which only
+// differ in these compile to the same program.
+std::string get_normalized(const std::string& kernstr);
+
+class Stats
+{
+  public:
+  // programs compiled through the store
+  size_t n_compiled;
+  // requests served by an existing program
+  size_t n_shared;
+  // programs currently held by at least one Program
+  size_t n_live;
+};
+
+// Process-wide store of compiled programs, shared by all Programs (those of the ProgramCacher
+// and those used in find). Different geometries often have identical copy (WSA, WSB) and
+// BETAC kernels, which are compiled once while any Program holds them. A program is released
+// when the last Program holding it is updated or destroyed.
+class ProgramStore
+{
+  private:
+  class Entry
+  {
+    public:
+    cl_context                   context;
+    cl_device_id                 device_id;
+    std::string                  build_options;
+    std::string                  normalized;
+    std::weak_ptr<SafeCLProgram> sclp;
+  };
+
+  std::mutex mutex;
+  // keyed by the hash of the normalized kernel string
+  std::unordered_map<size_t, std::vector<Entry>> entries;
+  size_t n_compiled = 0;
+  size_t n_shared   = 0;
+
+  std::shared_ptr<SafeCLProgram> find(size_t             hash,
+                                      cl_context         context,
+                                      cl_device_id       device_id,
+                                      const std::string& build_options,
+                                      const std::string& normalized);
+  void erase_expired();
+
+  public:
+  // Sets sclp to the program of kernstr. It is compiled only if there is no live program with
+  // the same normalized kernel string, context, device and build options. The lock is not
+  // held while compiling, so threads can compile different programs concurrently.
+  oclutil::Result get(cl_context                      context,
+                      cl_device_id                    device_id,
+                      const std::string&              kernstr,
+                      const std::string&              build_options,
+                      owrite::Writer&                 mowri,
+                      std::shared_ptr<SafeCLProgram>& sclp,
+                      bool&                           compiled);
+
+  Stats get_stats();
+};
+
+ProgramStore& get_program_store();
+}
+}
+
+#endif
@@ -23,6 +23,7 @@ class RandomUtil
   RandomUtil();
   RandomUtil(int seed);
   size_t get_from_range(size_t upper);
+  void   seed(int seed);
   template <typename T>
   void shuffle(size_t start_index, size_t end_index, T& t)
   {
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_ROOFLINE_HPP
+#define GUARD_MIOPENGEMM_ROOFLINE_HPP
+
+#include <array>
+#include <string>
+#include <vector>
+#include <miopengemm/bundle.hpp>
+#include <miopengemm/enums.hpp>
+#include <miopengemm/oclutil.hpp>
+#include <miopengemm/outputwriter.hpp>
+
+// The roofline model of the kernels of a Bundle : from the floating point operations and global
+// memory traffic of each kernel, and the peak throughput and bandwidth of the device, how close
+// a kernel is to the fastest it could be, and whether it is limited by compute or by memory.
+namespace MIOpenGEMM
+{
+namespace roofline
+{
+
+// The work of a kernel
+class Traffic
+{
+  public:
+  // useful floating point operations (2mnk for MAIN, not counting the overhang of edge tiles)
+  double flops = 0;
+  // bytes read from and written to global memory
+  double read_bytes  = 0;
+  double write_bytes = 0;
+
+  double get_bytes() const { return read_bytes + write_bytes; }
+  // flops per byte
+  double get_intensity() const;
+};
+
+// The work of each kernel of bundle, indexed by KType. Kernels not in the Bundle have no work.
+// MAIN reads all of A (B) once per column (row) of work groups, from the workspace if copied
+// there, and reads C as well as writing it if it does the beta scaling of C, once per split of
+// k (ICE). WSA, WSB and BETAC read and write all of A, B and C respectively, and PREP does the
+// work of the ones fused into it.
+std::array<Traffic, KType::E::N> get_traffic(const kerngen::Bundle& bundle);
+
+// The roofs of the device
+class Peaks
+{
+  public:
+  // peak floating point throughput [gflops], 0 if unknown
+  double gflops = 0;
+  // global memory bandwidth [GB/s], 0 if unknown
+  double bandwidth = 0;
+
+  // the intensity [flops / byte] above which kernels are compute bound
+  double get_ridge() const;
+};
+
+// gflops is estimated from the compute units and clock of devinfo, with 64 lanes per compute
+// unit each doing one fused multiply-add per cycle. For doubles, that is scaled by
+// $MIOPENGEMM_FP64_RATIO if set (0.5 for half rate), otherwise by the ratio of the fastest
+// product with the name of the device if known, otherwise gflops is 0. bandwidth is
+// $MIOPENGEMM_BANDWIDTH [GB/s] if set, otherwise that of the fastest product with the name of
+// the device if known, otherwise 0. Use measure_bandwidth to calibrate it.
+Peaks get_peaks(const oclutil::DevInfo& devinfo, char floattype);
+
+// The bandwidth [GB/s] of copying a buffer of n_bytes to another, the best of n_runs timed with
+// events. The command queue must have CL_QUEUE_PROFILING_ENABLE.
+double measure_bandwidth(cl_command_queue command_queue,
+                         size_t           n_bytes,
+                         size_t           n_runs,
+                         owrite::Writer&  mowri);
+
+// A kernel run, placed on the roofline
+class Point
+{
+  public:
+  KType::E ktype;
+  Traffic  traffic;
+  // [ms]
+  double time;
+
+  Point(KType::E ktype_, const Traffic& traffic_, double time_)
+    : ktype(ktype_), traffic(traffic_), time(time_)
+  {
+  }
+
+  double get_gflops() const;
+  // achieved bandwidth [GB/s]
+  double get_bandwidth() const;
+  // the time on the roofline over the time, in (0, 1]
+  double get_fraction_of_roofline(const Peaks& peaks) const;
+  // memory bound if moving its bytes at peak bandwidth takes longer than its flops at peak
+  bool is_memory_bound(const Peaks& peaks) const;
+};
+
+// A table of the points, one line each : intensity, gflops, bandwidth, fraction of roofline
+// and the bound
+std::string get_string(const std::vector<Point>& points, const Peaks& peaks);
+}
+}
+
+#endif
@@ -5,6 +5,7 @@
 #define GUARD_MIOPENGEMM_SETABCW_HPP
 
 #include <miopengemm/geometry.hpp>
+#include <miopengemm/oclutil.hpp>
 
 namespace MIOpenGEMM
 {
@@ -27,6 +28,24 @@ void set_multigeom_abc(const MatData<TFloat>& v_abc,
 template <typename TFloat>
 void set_abcw(const MatData<TFloat>& v_abcw, const Geometry& gg, const Offsets& toff);
 
+// Generation in chunks, for matrices too large to hold on the host. Element i of a matrix is a
+// function of (seed, i) only, so that chunks are independent, are generated in parallel, and
+// can be regenerated on the host later, for example for an accuracy test.
+template <typename TFloat>
+void fill_chunk(TFloat* chunk, size_t first, size_t n_elements, size_t seed);
+
+// default size of the chunks generated on the host for set_device_buffer
+const size_t default_chunk_bytes = 64 * 1024 * 1024;
+
+// Fill the first n_elements of buffer with the values of fill_chunk, without a host copy of the
+// buffer : 2 chunks are used in turn, the next being generated while the previous is written.
+template <typename TFloat>
+void set_device_buffer(cl_command_queue command_queue,
+                       cl_mem           buffer,
+                       size_t           n_elements,
+                       size_t           seed,
+                       size_t           chunk_elements = default_chunk_bytes / sizeof(TFloat));
+
 template <typename TFl>
 class CpuMemBundle
 {
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_SIMDEVICE_HPP
+#define GUARD_MIOPENGEMM_SIMDEVICE_HPP
+
+#include <array>
+#include <random>
+#include <string>
+#include <miopengemm/bundle.hpp>
+#include <miopengemm/enums.hpp>
+#include <miopengemm/oclutil.hpp>
+
+// A simulated device, used in place of OpenCL by Programs (and hence TinyZero) so that
+// find can be run end-to-end on a machine without a GPU. Compilation is a fixed delay, and
+// kernel times come from an analytic (roofline-like) model of the DerivedParams. The model
+// is crude : it is intended for benchmarking the search strategy, not the kernels.
+
+namespace MIOpenGEMM
+{
+namespace simdevice
+{
+
+class SimParams
+{
+  public:
+  // seconds slept for each kernel compilation (cached kernels are not recompiled)
+  double compile_delay = 0.0;
+  // peak floating point throughput [gflops]
+  double peak_gflops = 5600.;
+  // global memory bandwidth [GB/s]
+  double bandwidth = 320.;
+  // fixed cost of enqueueing a kernel [ms]
+  double launch_overhead = 0.005;
+  // relative standard deviation of the (multiplicative, Gaussian) run-to-run noise
+  double noise = 0.01;
+  // if true, running a kernel sleeps for its simulated time, so that
+  // find's time-based halting behaves as on a real device
+  bool sleep_on_run = false;
+  // seed for the noise generator
+  size_t seed = 1011;
+};
+
+// Device resources (compute units, LDS, etc) of the simulated device, modelled on a Fiji.
+oclutil::DevInfo get_devinfo(const std::string& identifier);
+
+class Device
+{
+  public:
+  SimParams        params;
+  oclutil::DevInfo devinfo;
+
+  Device(const SimParams&, const oclutil::DevInfo&);
+
+  // modelled time [ms] of each kernel in the Bundle, indexed by KType.
+  // kernels not in the Bundle have time -1.
+  std::array<double, KType::E::N> get_modelled_times(const kerngen::Bundle&) const;
+
+  // modelled time [ms] of the tiny kernel (see tinygenerator.hpp) on gg : it reads A, B and C
+  // and writes C once, at peak bandwidth or peak throughput, whichever is slower.
+  double get_tiny_time(const Geometry& gg) const;
+
+  // a noisy sample of a kernel with modelled time [ms]
+  double sample(double modelled_time);
+
+  // advance the simulated clock by t [ms], returns the new clock [ns]
+  size_t advance(double t);
+  size_t get_clock() const { return clock_ns; }
+
+  private:
+  std::default_random_engine       gen;
+  std::normal_distribution<double> nordis;
+  size_t                           clock_ns{0};
+
+  double get_main_time(const kerngen::Bundle&) const;
+  double get_memory_time(double n_bytes) const;
+};
+}
+}
+
+#endif
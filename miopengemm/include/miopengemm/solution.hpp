@@ -37,6 +37,10 @@ class Solution
   // Constraints imposed while searching for this solution
   Constraints constraints;
 
+  // v_tgks is the tiny kernel (see tinygenerator.hpp), not the kernels of hypas. hypas is then
+  // untuned, and should not be used as a tuned kernel (cache entry, warm start)
+  bool is_tiny = false;
+
   Solution(const Geometry&,
            double extime,
            const std::vector<KernBlob>&,
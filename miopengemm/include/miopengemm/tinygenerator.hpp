@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_TINYGENERATOR_HPP
+#define GUARD_MIOPENGEMM_TINYGENERATOR_HPP
+
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/error.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/kernelstring.hpp>
+
+namespace MIOpenGEMM
+{
+namespace tinygen
+{
+
+// Whether gg is small enough for the tiny kernel : all of A and B fit in LDS, and C is
+// covered by a few work groups.
+bool is_tiny(const Geometry& gg);
+
+// A single kernel computing C <- alpha*A*B + beta*C on a tiny geometry : each work group
+// loads all of A and B into LDS, then computes a slice of C, with the beta scaling fused.
+// Neither workspace nor other kernels are needed. Only the types of dp are used.
+KernBlob get_tiny_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+}
+}
+
+#endif
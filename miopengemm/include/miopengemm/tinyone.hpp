@@ -41,9 +41,13 @@ class TinyOne
 
   std::vector<std::vector<double>> benchgemm(const std::vector<HyPas>& hps, const Halt&);
 
+  // compile without running, see TinyZero::compile
+  void compile(const HyPas& hp);
+
   Solution find1(const FindParams& find_params, const Constraints& constraints);
 
-  void accuracy_test(const HyPas& hp);  //, const TFloat* c_true_for_test);
+  // run hp once, and verify C as per verification (see accuracytests.hpp)
+  void accuracy_test(const HyPas& hp, Verification::E verification = Verification::E::FULL);
 
   private:
   Geometry gg;
@@ -55,6 +59,10 @@ class TinyOne
   // used when no pointer constructor is used.
   std::array<std::vector<TFloat>, Mat::E::N> __cpu_mem;
 
+  // when no pointer constructor is used, the matrices are generated in chunks directly into
+  // the gpu memories (see setabcw::set_device_buffer), and only generated on the cpu when needed.
+  bool generated = false;
+
   std::vector<TFloat> c_copy;
   //  std::vector<TFloat> c_for_cpu_compute;
   owrite::Writer& mowri;
@@ -78,6 +86,9 @@ class TinyOne
 
   void initialise_cpu_mem_from_scratch();
 
+  // generates the cpu memories if they are not yet
+  void set_generated_cpu_mem();
+
   void initialise_cpu_mem(const TFloat* a_, const TFloat* b_, const TFloat* c_);
 
   void initialise_common();
@@ -64,7 +64,7 @@ class TinyTwo
   // get_up_moa<TFloat>()->accuracy_test(hp);
   //}
 
-  void accuracy_test(const HyPas& hp);
+  void accuracy_test(const HyPas& hp, Verification::E verification = Verification::E::FULL);
 };
 
 template <>
@@ -24,9 +24,12 @@
 #include <miopengemm/oclutil.hpp>
 #include <miopengemm/outputwriter.hpp>
 #include <miopengemm/programs.hpp>
+#include <miopengemm/roofline.hpp>
+#include <miopengemm/simdevice.hpp>
 #include <miopengemm/solution.hpp>
 #include <miopengemm/stringutilbase.hpp>
 #include <miopengemm/timer.hpp>
+#include <miopengemm/tracer.hpp>
 
 namespace MIOpenGEMM
 {
@@ -39,14 +42,25 @@ class FindTracker
   Timer  timer;
   size_t descents{0};
   size_t kernels{0};
+  // (elapsed time [s], gflops) each time a new best kernel is benchmarked
+  std::vector<std::pair<double, double>> records;
+  // if not nullptr, restarts and new best gflops are recorded here
+  std::shared_ptr<trace::Tracer> tracer;
 
   public:
+  FindTracker(std::shared_ptr<trace::Tracer> tracer_ = nullptr) : tracer(tracer_) {}
   void        start();
   void        incr_descents();
   void        incr_kernels();
+  void        record(double gflops);
   double      get_elapsed() const;
   size_t      get_descents() const;
+  size_t      get_kernels() const;
   std::string get_string() const;
+  // elapsed time [s] when a kernel within fraction of the best found was benchmarked
+  double get_time_to_fraction_of_best(double fraction) const;
+  // gflops of the best kernel benchmarked
+  double get_best_gflops() const;
 };
 
 // For bundling the 4 GPU memories (a, b, c, w), and managing the copy of c if it is needed
@@ -84,9 +98,24 @@ class TinyZero
            cl_mem           workspace_gpu_,
            owrite::Writer&  mowri_);
 
+  // No OpenCL : kernels are compiled and run on a simulated device
+  TinyZero(std::shared_ptr<simdevice::Device> simdev,
+           const Geometry                     gg_,
+           const Offsets                      toff_,
+           owrite::Writer&                    mowri_);
+
   std::vector<double> benchgemm(const HyPas& hp, const Halt& hl);
+  // generate and compile the kernels of hp without running them. benchgemm with the same hp
+  // will then not recompile, so that compilation can be done ahead of benchmarking.
+  void     compile(const HyPas& hp);
   Solution find0(const Constraints& constraint, const FindParams& find_params);
 
+  // the tracker of the most recent call to find0
+  const FindTracker& get_find_tracker() const { return last_ftrack; }
+
+  // record the timeline of find0 and benchgemm in tracer, or not if nullptr (see tracer.hpp)
+  void set_tracer(std::shared_ptr<trace::Tracer> tracer);
+
   private:
   cl_command_queue       command_queue;
   const Geometry         gg;
@@ -97,10 +126,19 @@ class TinyZero
 
   Programs    programs;
   KernelTimes kernel_times{};
+  FindTracker last_ftrack;
+
+  std::shared_ptr<trace::Tracer> tracer;
+
+  // the roofs of the device, and the work of the kernels of the most recent Bundle compiled
+  roofline::Peaks                            peaks;
+  std::array<roofline::Traffic, KType::E::N> traffic{};
 
   double get_gflops(double timems);
   std::string get_run_times_heading();
   std::string get_run_time_string(cl_int status);
+  // the fastest run of each kernel since kernel_times were reset, on the roofline
+  std::string get_roofline_string() const;
   void address_check_valid();
   void address_check_valid_and_reliable();
 
@@ -117,6 +155,8 @@ class TinyZero
                             const Halt&,
                             const AllKernArgs&);
 
+  kerngen::Bundle get_compiled_bundle(const HyPas& hp);
+
   AllKernArgs get_all_kern_args(const std::vector<KernBlob>& kernblobs) const;
 };
 }
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_TRACER_HPP
+#define GUARD_MIOPENGEMM_TRACER_HPP
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <miopengemm/timer.hpp>
+
+// A timeline of find, in Chrome's trace event format : the JSON written can be opened in
+// chrome://tracing or https://ui.perfetto.dev. Where owrite::Writer is for reading, a Tracer is
+// for seeing where time goes : kernel generation, compilation, benchmark runs, and the idle time
+// between them. TinyZero records to its Tracer if set (see TinyZero::set_tracer), or, if not set
+// and $MIOPENGEMM_TRACE is, to a Tracer written to the file $MIOPENGEMM_TRACE at the end of find0.
+namespace MIOpenGEMM
+{
+namespace trace
+{
+
+// (key, value) pairs shown with an event
+using Args = std::vector<std::pair<std::string, std::string>>;
+
+// Thread safe. Events on different threads are shown on different tracks.
+class Tracer
+{
+  public:
+  Tracer();
+
+  // the time [us] since the Tracer was constructed
+  double now() const;
+
+  // an event from t_start [us] to now
+  void complete(const std::string& name,
+                const std::string& category,
+                double             t_start,
+                const Args&        args = {});
+
+  // an event without duration, now
+  void instant(const std::string& name, const std::string& category, const Args& args = {});
+
+  // a value which changes over time, plotted on its own track. Non-finite values are written as 0
+  void counter(const std::string& name, double value);
+
+  size_t      get_n_events() const;
+  std::string get_json() const;
+  void        write(const std::string& filename) const;
+
+  private:
+  Timer                          timer;
+  mutable std::mutex             mutex;
+  std::vector<std::string>       events;
+  std::map<std::thread::id, int> tids;
+
+  // add an event at time t [us] on this thread's track. tail is the JSON after its time stamp
+  void add(const std::string& name,
+           const std::string& category,
+           char               phase,
+           double             t,
+           const std::string& tail);
+};
+
+// Records a complete event on tracer, from construction to destruction. Does nothing if tracer
+// is nullptr, so that tracing costs nothing when disabled.
+class Scope
+{
+  public:
+  Scope(Tracer* tracer, std::string name, std::string category, Args args = {});
+  ~Scope();
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  // an argument only known at the end of the scope
+  void add_arg(const std::string& key, const std::string& value);
+
+  private:
+  Tracer*     tracer;
+  std::string name;
+  std::string category;
+  Args        args;
+  double      t_start;
+};
+}
+}
+
+#endif
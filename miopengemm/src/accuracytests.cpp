@@ -1,11 +1,16 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <sstream>
+#include <thread>
 #include <vector>
 #include <miopengemm/accuracytests.hpp>
 #include <miopengemm/geometry.hpp>
 #include <miopengemm/outputwriter.hpp>
+#include <miopengemm/randomutil.hpp>
 
 namespace MIOpenGEMM
 {
@@ -13,23 +18,182 @@ namespace MIOpenGEMM
 namespace accuracytests
 {
 
-enum class Status
-{
-  UNCHECKED = 0,
-  INCORRECT,
-  CORRECT
-};
-
 /* TODO : document logic. are matrices positive or zero centeted?
  * Provide better diagnostics when not correct.
  * Output full matrices to files for visualisation. etc etc etc. */
 
+// abs(cpu - gpu) / (abs(alpha)*abs(A)abs(B) + abs(beta)*abs(C)) must not exceed this
+const double threshold = 1e-6;
+
 template <typename T>
 bool exactly_equal(T a, T b)
 {
   return ((std::isnan(a) && std::isnan(b)) || (a >= b && a <= b));
 }
 
+namespace
+{
+
+// the zones of C : before the matrix, after it, the matrix proper, and its ldX padding
+enum Zone
+{
+  OFFSET = 0,
+  TAIL,
+  MATRIX,
+  LDX,
+  N_ZONES
+};
+
+// number of errors to print for each of the zones
+const size_t n_per_zone = 25;
+
+// what a pass over a part of C finds : the error statistics, and the first offenders in each zone
+struct Findings
+{
+  double                                        max_abs_err  = 0;
+  double                                        max_rel_err  = 0;
+  double                                        max_test_err = 0;
+  std::array<size_t, N_ZONES>                   n_errs{{0, 0, 0, 0}};
+  std::array<std::vector<std::string>, N_ZONES> offenders;
+
+  void add_offender(Zone zone, const std::string& offender)
+  {
+    if (offenders[zone].size() < n_per_zone)
+    {
+      offenders[zone].push_back(offender);
+    }
+    ++n_errs[zone];
+  }
+
+  // f is of a later part of C
+  void merge(const Findings& f)
+  {
+    max_abs_err  = std::max(max_abs_err, f.max_abs_err);
+    max_rel_err  = std::max(max_rel_err, f.max_rel_err);
+    max_test_err = std::max(max_test_err, f.max_test_err);
+    for (size_t zone = 0; zone < N_ZONES; ++zone)
+    {
+      for (size_t i = 0; i < f.offenders[zone].size() && offenders[zone].size() < n_per_zone; ++i)
+      {
+        offenders[zone].push_back(f.offenders[zone][i]);
+      }
+      n_errs[zone] += f.n_errs[zone];
+    }
+  }
+};
+
+template <typename TFloat>
+class ElementwiseComparer
+{
+  public:
+  ElementwiseComparer(const Geometry& gg_,
+                      const Offsets&  toff_,
+                      const TFloat*   c_before_,
+                      const TFloat*   c_cpu_,
+                      const TFloat*   c_gpu_,
+                      const TFloat*   c_cpu_abs_)
+    : gg(gg_), toff(toff_), c_before(c_before_), c_cpu(c_cpu_), c_gpu(c_gpu_), c_cpu_abs(c_cpu_abs_)
+  {
+  }
+
+  std::string get_message(size_t i) const
+  {
+    std::stringstream ss;
+    ss << "\nc_before : " << c_before[i] << "   c_cpu : " << c_cpu[i] << "   c_gpu : " << c_gpu[i]
+       << "   c_cpu_abs : " << c_cpu_abs[i] << "\n\n";
+    return ss.str();
+  }
+
+  // the pre-padding and the post-padding zones
+  void compare_padding(Findings& fi) const
+  {
+    size_t nels = get_mat_size(gg, toff, Mat::E::C);
+    for (size_t i = 0; i < toff.offsets[Mem::E::C]; ++i)
+    {
+      if (!exactly_equal(c_cpu[i], c_gpu[i]))
+      {
+        std::stringstream ss;
+        ss << "(in offset, " << i << '/' << toff.offsets[Mem::E::C] << ')' << get_message(i);
+        fi.add_offender(OFFSET, ss.str());
+      }
+    }
+
+    for (size_t i = toff.offsets[Mem::E::C] + gg.get_padded_area(Mat::E::C); i < nels; ++i)
+    {
+      if (!exactly_equal(c_cpu[i], c_gpu[i]))
+      {
+        std::stringstream ss;
+        ss << "(in tail, " << nels - i << '/' << toff.tails[Mem::E::C] << ')' << get_message(i);
+        fi.add_offender(TAIL, ss.str());
+      }
+    }
+  }
+
+  // the rows [i0, i1) of the matrix proper and of its ldX zone. Rows are along the coalesced
+  // dimension of C. Rows without errors, the common case, are a single branch free pass.
+  void compare_rows(size_t i0, size_t i1, Findings& fi) const
+  {
+    size_t n_coal = gg.get_coal(Mat::E::C);
+    size_t ldc    = gg.ldX[Mat::E::C];
+    for (size_t i = i0; i < i1; ++i)
+    {
+      size_t        row0    = toff.offsets[Mem::E::C] + i * ldc;
+      const TFloat* cpu     = c_cpu + row0;
+      const TFloat* gpu     = c_gpu + row0;
+      const TFloat* cpu_abs = c_cpu_abs + row0;
+      size_t        n_bad   = 0;
+      for (size_t j = 0; j < n_coal; ++j)
+      {
+        double abs_err  = std::abs(static_cast<double>(cpu[j]) - static_cast<double>(gpu[j]));
+        double rel_err  = abs_err / (std::abs(static_cast<double>(cpu[j])) + 1e-9);
+        double test_err = abs_err / std::max<double>(cpu_abs[j], 1e-9);
+        fi.max_abs_err  = std::max(fi.max_abs_err, abs_err);
+        fi.max_rel_err  = std::max(fi.max_rel_err, rel_err);
+        fi.max_test_err = std::max(fi.max_test_err, test_err);
+        // written so that a nan fails
+        n_bad += !(test_err <= threshold);
+      }
+
+      for (size_t j = 0; n_bad != 0 && j < n_coal; ++j)
+      {
+        double abs_err  = std::abs(static_cast<double>(cpu[j]) - static_cast<double>(gpu[j]));
+        double test_err = abs_err / std::max<double>(cpu_abs[j], 1e-9);
+        if (!(test_err <= threshold))
+        {
+          std::stringstream ss;
+          ss << "(in matrix zone, "
+             << "uncoal = " << i << "/" << gg.get_uncoal(Mat::E::C) << ", coal = " << j << "/"
+             << ldc << ")\n"
+             << "abs(cpu - gpu)/max(absgemm, 1e-9)=" << test_err << ">" << threshold << ". "
+             << get_message(row0 + j);
+          fi.add_offender(MATRIX, ss.str());
+        }
+      }
+
+      for (size_t j = n_coal; j < ldc; ++j)
+      {
+        if (!exactly_equal(cpu[j], gpu[j]))
+        {
+          std::stringstream ss;
+          ss << "(in ldX zone, "
+             << "uncoal = " << i << "/" << gg.get_uncoal(Mat::E::C) << ", coal = " << j << "/"
+             << ldc << ")" << get_message(row0 + j);
+          fi.add_offender(LDX, ss.str());
+        }
+      }
+    }
+  }
+
+  private:
+  const Geometry& gg;
+  const Offsets&  toff;
+  const TFloat*   c_before;
+  const TFloat*   c_cpu;
+  const TFloat*   c_gpu;
+  const TFloat*   c_cpu_abs;
+};
+}
+
 template <typename TFloat>
 void elementwise_compare(const Geometry& gg,
                          const Offsets&  toff,
@@ -40,123 +204,370 @@ void elementwise_compare(const Geometry& gg,
                          std::string     info_str,
                          owrite::Writer& mowri)
 {
-  double threshold      = 1e-6;
-  size_t nels           = get_mat_size(gg, toff, Mat::E::C);
-  size_t n_mat_els      = gg.get_padded_area(Mat::E::C);
-  size_t n_errs_printed = 0;
-  double max_abs_err    = 0;
-  double max_rel_err    = 0;
-  double max_test_err   = 0;
-  size_t n_per_category = 25;  // number of errors to print for the 4 different regions.
+  ElementwiseComparer<TFloat> comparer(gg, toff, c_before, c_cpu, c_gpu, c_cpu_abs);
 
-  std::vector<Status> status(nels, Status::UNCHECKED);
-  std::stringstream   errm;
+  // the rows of C are shared between threads, each with its own findings
+  size_t n_rows    = gg.get_uncoal(Mat::E::C);
+  size_t n_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  n_threads        = std::max<size_t>(1, std::min(n_threads, n_rows));
+  std::vector<Findings>    findings(n_threads + 1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < n_threads; ++t)
+  {
+    size_t i0 = (t * n_rows) / n_threads;
+    size_t i1 = ((t + 1) * n_rows) / n_threads;
+    threads.emplace_back(
+      [&comparer, &findings, t, i0, i1]() { comparer.compare_rows(i0, i1, findings[t + 1]); });
+  }
+  comparer.compare_padding(findings[0]);
+  for (auto& t : threads)
+  {
+    t.join();
+  }
 
-  errm << info_str << '\n';
+  Findings fi;
+  for (auto& f : findings)
+  {
+    fi.merge(f);
+  }
 
-  auto get_message = [c_before, c_cpu, c_gpu, c_cpu_abs, &gg, &toff](size_t i) {
-    std::stringstream ss;
-    ss << "\nc_before : " << c_before[i] << "   c_cpu : " << c_cpu[i] << "   c_gpu : " << c_gpu[i]
-       << "   c_cpu_abs : " << c_cpu_abs[i] << "\n\n";
-    return ss.str();
-  };
+  size_t n_errs = 0;
+  for (auto zone_n_errs : fi.n_errs)
+  {
+    n_errs += zone_n_errs;
+  }
 
-  size_t zone = 1;
-  // First check the pre-padding zone,
-  for (size_t i = 0; i < toff.offsets[Mem::E::C]; ++i)
+  if (n_errs != 0)
   {
-    status[i] = exactly_equal(c_cpu[i], c_gpu[i]) ? Status::CORRECT : Status::INCORRECT;
-    if (status[i] == Status::INCORRECT && n_errs_printed < zone * n_per_category)
+    std::stringstream errm;
+    errm << info_str << '\n';
+    for (auto zone : {OFFSET, TAIL, MATRIX, LDX})
     {
-      ++n_errs_printed;
-      errm << "(in offset, " << i << '/' << toff.offsets[Mem::E::C] << ')' << get_message(i);
+      for (auto& offender : fi.offenders[zone])
+      {
+        errm << offender;
+      }
     }
+    errm << "errors (offset, tail, matrix zone, ldX zone) : (" << fi.n_errs[OFFSET] << ", "
+         << fi.n_errs[TAIL] << ", " << fi.n_errs[MATRIX] << ", " << fi.n_errs[LDX] << ").";
+    throw miog_error(errm.str());
   }
-  ++zone;
 
-  // Now check the post-padding zone,
-  for (size_t i = toff.offsets[Mem::E::C] + n_mat_els; i < nels; ++i)
+  mowri.bw[OutPart::E::ACC] << '[' << "max_abs_err=" << fi.max_abs_err
+                            << "   max_rel_err=" << fi.max_rel_err
+                            << "   max_test_err=" << fi.max_test_err << ']' << Flush;
+}
+
+namespace
+{
+
+// the indices in memory of the elements of A (m x k), B (k x n) and C (m x n), offsets included
+class Layout
+{
+  public:
+  Layout(const Geometry& gg_, const Offsets& toff) : gg(gg_)
   {
-    status[i] = exactly_equal(c_cpu[i], c_gpu[i]) ? Status::CORRECT : Status::INCORRECT;
-    if (status[i] == Status::INCORRECT && n_errs_printed < zone * n_per_category)
+    for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
     {
-      ++n_errs_printed;
-      errm << "(in tail, " << nels - i << '/' << toff.tails[Mem::E::C] << ')' << get_message(i);
+      offset[emat] = toff.offsets[emat];
+      ld[emat]     = gg.ldX[emat];
     }
+    pll_k_a  = gg.coal_is_pll_k(Mat::E::A);
+    pll_k_b  = gg.coal_is_pll_k(Mat::E::B);
+    m_coal_c = (gg.tX[Mat::E::C] + gg.isColMajor) % 2 == 1;
   }
-  ++zone;
 
-  // Now check the matrix proper zone,
-  for (size_t i = 0; i < gg.get_uncoal(Mat::E::C); ++i)
+  size_t get_a(size_t x, size_t z) const
   {
-    for (size_t j = 0; j < gg.get_coal(Mat::E::C); ++j)
+    return offset[Mat::E::A] + (pll_k_a ? z + x * ld[Mat::E::A] : x + z * ld[Mat::E::A]);
+  }
+
+  // false if the element is in the padding of the image of an implicit B
+  bool get_b(size_t z, size_t y, size_t& index) const
+  {
+    if (gg.conv.is_set())
     {
-      size_t coord = toff.offsets[Mem::E::C] + i * gg.ldX[Mat::E::C] + j;
-      max_abs_err =
-        std::max<double>(max_abs_err, static_cast<double>(std::abs(c_cpu[coord] - c_gpu[coord])));
-      max_rel_err    = max_abs_err / (std::abs(static_cast<double>(c_cpu[coord])) + 1e-9);
-      double relerr1 = static_cast<double>(std::abs(c_cpu[coord] - c_gpu[coord])) /
-                       (std::max<double>(static_cast<double>(c_cpu_abs[coord]), 1e-9));
+      bool in_image = gg.conv.get_image_index(z, y, index);
+      if (in_image)
+      {
+        index += offset[Mat::E::B];
+      }
+      return in_image;
+    }
+    index = offset[Mat::E::B] + (pll_k_b ? z + y * ld[Mat::E::B] : y + z * ld[Mat::E::B]);
+    return true;
+  }
+
+  size_t get_c(size_t x, size_t y) const
+  {
+    return offset[Mat::E::C] + (m_coal_c ? x + y * ld[Mat::E::C] : y + x * ld[Mat::E::C]);
+  }
 
-      max_test_err = std::max<double>(relerr1, max_test_err);
+  private:
+  const Geometry& gg;
+  size_t          offset[Mat::E::N];
+  size_t          ld[Mat::E::N];
+  bool            pll_k_a;
+  bool            pll_k_b;
+  bool            m_coal_c;
+};
 
-      status[coord] = relerr1 > threshold ? Status::INCORRECT : Status::CORRECT;
-      if (status[coord] == Status::INCORRECT && n_errs_printed < zone * n_per_category)
+template <typename TFloat>
+double get_scaled_c(TFloat beta, TFloat c)
+{
+  // as in cpugemm, C is overwritten when beta is 0
+  return (beta > 0 || beta < 0) ? static_cast<double>(beta) * c : 0.;
+}
+
+// the elements of C outside the matrix proper (offset, tail and ldX padding) must be unchanged
+template <typename TFloat>
+void check_padding(const Geometry&    gg,
+                   const Offsets&     toff,
+                   const TFloat*      c_before,
+                   const TFloat*      c_gpu,
+                   size_t             n_to_print,
+                   bool&              was_error,
+                   std::stringstream& errm)
+{
+  size_t n_errs = 0;
+  auto   check  = [c_before, c_gpu, n_to_print, &n_errs, &errm](size_t i, const char* zone) {
+    if (!exactly_equal(c_before[i], c_gpu[i]))
+    {
+      if (n_errs < n_to_print)
       {
-        ++n_errs_printed;
-        errm << "(in matrix zone, "
-             << "uncoal = " << i << "/" << gg.get_uncoal(Mat::E::C) << ", coal = " << j << "/"
-             << gg.ldX[Mat::E::C] << ")\n"
-             << "abs(cpu - gpu)/max(absgemm, 1e-9)=" << relerr1 << ">" << threshold << ". "
-             << get_message(coord);
+        errm << "(in " << zone << ", index " << i << ") c_before : " << c_before[i]
+             << "   c_gpu : " << c_gpu[i] << '\n';
       }
+      ++n_errs;
     }
-  }
-  ++zone;
+  };
 
-  // Finally, check the matrix ldx zone,
+  size_t nels   = get_mat_size(gg, toff, Mat::E::C);
+  size_t offset = toff.offsets[Mem::E::C];
+  for (size_t i = 0; i < offset; ++i)
+  {
+    check(i, "offset");
+  }
+  for (size_t i = offset + gg.get_padded_area(Mat::E::C); i < nels; ++i)
+  {
+    check(i, "tail");
+  }
   for (size_t i = 0; i < gg.get_uncoal(Mat::E::C); ++i)
   {
     for (size_t j = gg.get_coal(Mat::E::C); j < gg.ldX[Mat::E::C]; ++j)
     {
-      size_t coord = toff.offsets[Mem::E::C] + i * gg.ldX[Mat::E::C] + j;
+      check(offset + i * gg.ldX[Mat::E::C] + j, "ldX zone");
+    }
+  }
+  was_error |= n_errs != 0;
+}
+}
 
-      status[coord] =
-        exactly_equal(c_cpu[coord], c_gpu[coord]) ? Status::CORRECT : Status::INCORRECT;
+template <typename TFloat>
+void sampled_compare(const Geometry& gg,
+                     const Offsets&  toff,
+                     const TFloat*   a,
+                     const TFloat*   b,
+                     const TFloat*   c_before,
+                     const TFloat*   c_gpu,
+                     TFloat          alpha,
+                     TFloat          beta,
+                     size_t          n_samples,
+                     size_t          seed,
+                     std::string     info_str,
+                     owrite::Writer& mowri)
+{
+  size_t            n_to_print   = 25;
+  size_t            n_errs       = 0;
+  bool              was_error    = false;
+  double            max_abs_err  = 0;
+  double            max_test_err = 0;
+  Layout            lay(gg, toff);
+  std::stringstream errm;
+
+  errm << info_str << "\n(sampled, seed " << seed << ")\n";
+  check_padding(gg, toff, c_before, c_gpu, n_to_print, was_error, errm);
 
-      if (status[coord] == Status::INCORRECT && n_errs_printed < zone * n_per_category)
+  // the (x, y) coordinates of the elements of C to check
+  std::vector<std::array<size_t, 2>> samples;
+  if (gg.m * gg.n <= n_samples)
+  {
+    for (size_t y = 0; y < gg.n; ++y)
+    {
+      for (size_t x = 0; x < gg.m; ++x)
       {
-        ++n_errs_printed;
-        errm << "(in ldX zone, "
-             << "uncoal = " << i << "/" << gg.get_uncoal(Mat::E::C) << ", coal = " << j << "/"
-             << gg.ldX[Mat::E::C] << ")" << get_message(coord);
+        samples.push_back({{x, y}});
       }
     }
   }
-  ++zone;
+  else
+  {
+    samples = {{{0, 0}}, {{gg.m - 1, 0}}, {{0, gg.n - 1}}, {{gg.m - 1, gg.n - 1}}};
+    RandomUtil radu(static_cast<int>(seed));
+    while (samples.size() < n_samples)
+    {
+      samples.push_back({{radu.get_from_range(gg.m), radu.get_from_range(gg.n)}});
+    }
+  }
 
-  bool was_error = false;
-  for (size_t i = 0; i < nels; ++i)
+  for (auto& sample : samples)
   {
-    if (status[i] == Status::UNCHECKED)
+    size_t x   = sample[0];
+    size_t y   = sample[1];
+    double dot = 0;
+    double abs = 0;
+    for (size_t z = 0; z < gg.k; ++z)
     {
-      std::stringstream err2;
-      err2 << "logic error, index " << i << " was not checked.";
-      throw miog_error(err2.str());
+      size_t index = 0;
+      if (lay.get_b(z, y, index))
+      {
+        dot += static_cast<double>(a[lay.get_a(x, z)]) * b[index];
+        abs += std::abs(static_cast<double>(a[lay.get_a(x, z)]) * b[index]);
+      }
     }
-    else if (status[i] == Status::INCORRECT)
+    size_t ic      = lay.get_c(x, y);
+    double c_ref   = alpha * dot + get_scaled_c(beta, c_before[ic]);
+    double c_abs   = std::abs(alpha * abs) + std::abs(get_scaled_c(beta, c_before[ic]));
+    double abs_err = std::abs(c_ref - c_gpu[ic]);
+    double relerr  = abs_err / std::max<double>(c_abs, 1e-9);
+    max_abs_err    = std::max<double>(max_abs_err, abs_err);
+    max_test_err   = std::max<double>(max_test_err, relerr);
+
+    // written so that a nan fails
+    if (!(relerr <= threshold))
     {
+      if (n_errs < n_to_print)
+      {
+        errm << "(m = " << x << "/" << gg.m << ", n = " << y << "/" << gg.n << ")\n"
+             << "abs(cpu - gpu)/max(absgemm, 1e-9)=" << relerr << ">" << threshold
+             << ".\nc_before : " << c_before[ic] << "   c_cpu : " << c_ref
+             << "   c_gpu : " << c_gpu[ic] << "   c_cpu_abs : " << c_abs << "\n\n";
+      }
+      ++n_errs;
       was_error = true;
     }
   }
 
   if (was_error)
   {
+    errm << n_errs << " of the " << samples.size() << " sampled elements are incorrect.";
     throw miog_error(errm.str());
   }
 
-  mowri.bw[OutPart::E::ACC] << '[' << "max_abs_err=" << max_abs_err
-                            << "   max_rel_err=" << max_rel_err
+  mowri.bw[OutPart::E::ACC] << '[' << "n_samples=" << samples.size()
+                            << "   max_abs_err=" << max_abs_err
+                            << "   max_test_err=" << max_test_err << ']' << Flush;
+}
+
+template <typename TFloat>
+void freivalds_compare(const Geometry& gg,
+                       const Offsets&  toff,
+                       const TFloat*   a,
+                       const TFloat*   b,
+                       const TFloat*   c_before,
+                       const TFloat*   c_gpu,
+                       TFloat          alpha,
+                       TFloat          beta,
+                       size_t          n_projections,
+                       size_t          seed,
+                       std::string     info_str,
+                       owrite::Writer& mowri)
+{
+  size_t            n_to_print   = 25;
+  size_t            n_errs       = 0;
+  bool              was_error    = false;
+  double            max_test_err = 0;
+  Layout            lay(gg, toff);
+  RandomUtil        radu(static_cast<int>(seed));
+  std::stringstream errm;
+
+  errm << info_str << "\n(Freivalds, seed " << seed << ")\n";
+  check_padding(gg, toff, c_before, c_gpu, n_to_print, was_error, errm);
+
+  // abs(B)*abs(x) and abs(beta*C_before)*abs(x), the same for all projections as abs(x) = 1
+  std::vector<double> abs_bx(gg.k, 0);
+  std::vector<double> abs_c_before_x(gg.m, 0);
+  for (size_t y = 0; y < gg.n; ++y)
+  {
+    for (size_t z = 0; z < gg.k; ++z)
+    {
+      size_t index = 0;
+      abs_bx[z] += lay.get_b(z, y, index) ? std::abs(static_cast<double>(b[index])) : 0;
+    }
+    for (size_t x = 0; x < gg.m; ++x)
+    {
+      abs_c_before_x[x] += std::abs(get_scaled_c(beta, c_before[lay.get_c(x, y)]));
+    }
+  }
+
+  for (size_t p = 0; p < n_projections; ++p)
+  {
+    std::vector<double> xs(gg.n);
+    for (auto& v : xs)
+    {
+      v = radu.get_from_range(2) == 0 ? -1. : 1.;
+    }
+
+    // B*x, then C_gpu*x and beta*C_before*x
+    std::vector<double> bx(gg.k, 0);
+    std::vector<double> c_gpu_x(gg.m, 0);
+    std::vector<double> c_ref_x(gg.m, 0);
+    for (size_t y = 0; y < gg.n; ++y)
+    {
+      for (size_t z = 0; z < gg.k; ++z)
+      {
+        size_t index = 0;
+        bx[z] += lay.get_b(z, y, index) ? xs[y] * b[index] : 0;
+      }
+      for (size_t x = 0; x < gg.m; ++x)
+      {
+        size_t ic = lay.get_c(x, y);
+        c_gpu_x[x] += xs[y] * c_gpu[ic];
+        c_ref_x[x] += xs[y] * get_scaled_c(beta, c_before[ic]);
+      }
+    }
+
+    // alpha*A*(B*x), and its bound
+    std::vector<double> abx(gg.m, 0);
+    std::vector<double> abs_abx(gg.m, 0);
+    for (size_t z = 0; z < gg.k; ++z)
+    {
+      for (size_t x = 0; x < gg.m; ++x)
+      {
+        double a_xz = a[lay.get_a(x, z)];
+        abx[x] += a_xz * bx[z];
+        abs_abx[x] += std::abs(a_xz) * abs_bx[z];
+      }
+    }
+
+    for (size_t x = 0; x < gg.m; ++x)
+    {
+      c_ref_x[x] += alpha * abx[x];
+      double c_abs  = std::abs(static_cast<double>(alpha)) * abs_abx[x] + abs_c_before_x[x];
+      double relerr = std::abs(c_ref_x[x] - c_gpu_x[x]) / std::max<double>(c_abs, 1e-9);
+      max_test_err  = std::max<double>(max_test_err, relerr);
+      if (!(relerr <= threshold))
+      {
+        if (n_errs < n_to_print)
+        {
+          errm << "(projection " << p << ", m = " << x << "/" << gg.m << ")\n"
+               << "abs(cpu - gpu)/max(absgemm, 1e-9)=" << relerr << ">" << threshold
+               << ".\n(C*x)_cpu : " << c_ref_x[x] << "   (C*x)_gpu : " << c_gpu_x[x]
+               << "   (C*x)_cpu_abs : " << c_abs << "\n\n";
+        }
+        ++n_errs;
+        was_error = true;
+      }
+    }
+  }
+
+  if (was_error)
+  {
+    errm << n_errs << " rows of the " << n_projections << " projections are incorrect.";
+    throw miog_error(errm.str());
+  }
+
+  mowri.bw[OutPart::E::ACC] << '[' << "n_projections=" << n_projections
                             << "   max_test_err=" << max_test_err << ']' << Flush;
 }
 
@@ -177,5 +588,57 @@ template void elementwise_compare(const Geometry& gg,
                                   const double*   c_cpu_abs,
                                   std::string,
                                   owrite::Writer& mowri);
+
+template void sampled_compare(const Geometry& gg,
+                              const Offsets&  toff,
+                              const float*    a,
+                              const float*    b,
+                              const float*    c_before,
+                              const float*    c_gpu,
+                              float           alpha,
+                              float           beta,
+                              size_t          n_samples,
+                              size_t          seed,
+                              std::string     info_str,
+                              owrite::Writer& mowri);
+
+template void sampled_compare(const Geometry& gg,
+                              const Offsets&  toff,
+                              const double*   a,
+                              const double*   b,
+                              const double*   c_before,
+                              const double*   c_gpu,
+                              double          alpha,
+                              double          beta,
+                              size_t          n_samples,
+                              size_t          seed,
+                              std::string     info_str,
+                              owrite::Writer& mowri);
+
+template void freivalds_compare(const Geometry& gg,
+                                const Offsets&  toff,
+                                const float*    a,
+                                const float*    b,
+                                const float*    c_before,
+                                const float*    c_gpu,
+                                float           alpha,
+                                float           beta,
+                                size_t          n_projections,
+                                size_t          seed,
+                                std::string     info_str,
+                                owrite::Writer& mowri);
+
+template void freivalds_compare(const Geometry& gg,
+                                const Offsets&  toff,
+                                const double*   a,
+                                const double*   b,
+                                const double*   c_before,
+                                const double*   c_gpu,
+                                double          alpha,
+                                double          beta,
+                                size_t          n_projections,
+                                size_t          seed,
+                                std::string     info_str,
+                                owrite::Writer& mowri);
 }
 }
@@ -65,7 +65,7 @@ class AlphaGenerator : public basegen::BaseGenerator
   }
 
   private:
-  void append_group_allocation_string(std::stringstream& ss)
+  void append_group_allocation_string(emit::Emitter& ss)
   {
     if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::BYCOL)
     {
@@ -148,16 +148,107 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
       }
     }
 
+    else if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::MORTON ||
+             hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::HILBERT)
+    {
+      append_sfc_group_allocation_string(ss);
+    }
+
     else
     {
       std::stringstream err_ss;
       err_ss << "Invalid group_allocation parameter : " << hp.sus[Mat::E::C].vs[NonChi::E::GAL]
-             << ". It should be one of 1/2/3.";
+             << ". It should be one of 1/2/3/4/5.";
       throw miog_error(err_ss.str());
     }
   }
 
-  void append_super_column_width_defn(std::stringstream& ss)
+  // the number of groups in full space filling curve blocks, in dimension emat_x
+  size_t get_sfc_groups(Mat::E emat_x)
+  {
+    return dp.at(emat_x).n_groups - dp.at(emat_x).n_groups % dp.sfc_block_width;
+  }
+
+  void append_sfc_group_allocation_string(emit::Emitter& ss)
+  {
+    ss <<
+      R"(
+/* GROUP_ALLOCATION = 4 (Morton) or 5 (Hilbert) : the work groups in the first
+ * SFC_GROUPS_A x SFC_GROUPS_B groups are allocated block-by-block (column-by-column over
+ * blocks), following the curve within each SFC_BLOCK_WIDTH x SFC_BLOCK_WIDTH block, so that
+ * work groups running together share tiles of a and b. The remaining groups, below and to the
+ * right, are allocated column-by-column */
+TINTA group_id_a;
+TINTB group_id_b;
+if (group_id_xy < SFC_GROUPS_A*SFC_GROUPS_B){
+const TINTC sfc_block = group_id_xy / (SFC_BLOCK_WIDTH*SFC_BLOCK_WIDTH);
+TINTC sfc_d = group_id_xy % (SFC_BLOCK_WIDTH*SFC_BLOCK_WIDTH);
+TSHORT sfc_a = 0;
+TSHORT sfc_b = 0;
+)";
+
+    if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::MORTON)
+    {
+      ss << R"(/* de-interleave the bits of sfc_d */
+for (TSHORT s = 0; (1 << s) < SFC_BLOCK_WIDTH; ++s){
+sfc_a |= ((sfc_d >> (2*s)) & 1) << s;
+sfc_b |= ((sfc_d >> (2*s + 1)) & 1) << s;
+}
+)";
+    }
+    else
+    {
+      ss << R"(/* position sfc_d along the Hilbert curve */
+for (TSHORT s = 1; s < SFC_BLOCK_WIDTH; s *= 2){
+const TSHORT rx = 1 & (sfc_d / 2);
+const TSHORT ry = 1 & (sfc_d ^ rx);
+if (ry == 0){
+if (rx == 1){
+sfc_a = s - 1 - sfc_a;
+sfc_b = s - 1 - sfc_b;
+}
+const TSHORT sfc_swap = sfc_a;
+sfc_a = sfc_b;
+sfc_b = sfc_swap;
+}
+sfc_a += s*rx;
+sfc_b += s*ry;
+sfc_d /= 4;
+}
+)";
+    }
+
+    ss << R"(group_id_a = (sfc_block % (SFC_GROUPS_A / SFC_BLOCK_WIDTH))*SFC_BLOCK_WIDTH + sfc_a;
+group_id_b = (sfc_block / (SFC_GROUPS_A / SFC_BLOCK_WIDTH))*SFC_BLOCK_WIDTH + sfc_b;
+}
+)";
+
+    if (get_sfc_groups(Mat::E::A) != dp.at(Mat::E::A).n_groups)
+    {
+      ss << R"(
+/* below the blocks */
+else if (group_id_xy < N_GROUPS_A*SFC_GROUPS_B){
+const TINTC sfc_rem = group_id_xy - SFC_GROUPS_A*SFC_GROUPS_B;
+group_id_a = SFC_GROUPS_A + sfc_rem % (N_GROUPS_A - SFC_GROUPS_A);
+group_id_b = sfc_rem / (N_GROUPS_A - SFC_GROUPS_A);
+}
+)";
+    }
+
+    if (get_sfc_groups(Mat::E::B) != dp.at(Mat::E::B).n_groups)
+    {
+      ss << R"(
+/* to the right of the blocks */
+else {
+const TINTC sfc_rem = group_id_xy - N_GROUPS_A*SFC_GROUPS_B;
+group_id_a = sfc_rem % N_GROUPS_A;
+group_id_b = SFC_GROUPS_B + sfc_rem / N_GROUPS_A;
+}
+)";
+    }
+  }
+
+  void append_super_column_width_defn(emit::Emitter& ss)
   {
 
     if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == 3)
@@ -173,11 +264,23 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
             "*/";
       ss << "\n#define LAST_SUPER_COLUMN_WIDTH " << dp.ga3_last_super_column_width;
     }
+
+    else if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::MORTON ||
+             hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::HILBERT)
+    {
+      ss << "\n\n/* The width of the square blocks of work groups along which the space "
+            "filling curve runs (GROUP_ALLOCATION 4 and 5). It is ~ sqrt (N_TARGET_ACTIVE_WORKGROUPS "
+            "/ N_WORK_ITEMS_PER_C_ELM), a power of 2 */";
+      ss << "\n#define SFC_BLOCK_WIDTH " << dp.sfc_block_width;
+      ss << "\n/* the number of groups in full blocks, in the a and b dimensions */";
+      ss << "\n#define SFC_GROUPS_A " << get_sfc_groups(Mat::E::A);
+      ss << "\n#define SFC_GROUPS_B " << get_sfc_groups(Mat::E::B);
+    }
   }
 
-  void append_split_on_k_vardecl_write_string(std::stringstream& ss)
+  void append_split_on_k_vardecl_write_string(emit::Emitter& ss)
   {
-    if (dp.main_split_on_k != 0)
+    if (dp.main_split_on_k != 0 || dp.main_stream_k != 0)
     {
       ss <<
         R"(
@@ -191,17 +294,17 @@ TFLOAT previous_value; )"
     }
   }
 
-  void append_loop_var_bound_incr(std::stringstream& ss,
-                                  std::string        varname,
-                                  std::string        bound_string,
-                                  std::string        increment_string,
-                                  Mat::E             emat_x)
+  void append_loop_var_bound_incr(emit::Emitter& ss,
+                                  std::string    varname,
+                                  std::string    bound_string,
+                                  std::string    increment_string,
+                                  Mat::E         emat_x)
   {
     ss << "for (TINT" << Mat::M().name[emat_x] << ' ' << varname << " = 0; " << varname << " < "
        << bound_string << "; " << increment_string << ")";
   }
 
-  void append_load_for_perp(Mat::E emat_x, std::stringstream& ss)
+  void append_load_for_perp(Mat::E emat_x, emit::Emitter& ss)
   {
 
     char X = Mat::M().name[emat_x];
@@ -213,15 +316,15 @@ TFLOAT previous_value; )"
     bound_string += "/VEW_";
     bound_string += X;
 
-    std::stringstream incr_liw;
-    incr_liw << "mu_perp_i += MACRO_TILE_LENGTH_" << X << "/MICRO_" << X << "_TILE_PERP_UNROLL";
     std::string increment_string =
-      hp.sus[emat_x].vs[Chi::E::LIW] == 0 ? "++mu_perp_i" : incr_liw.str();
+      hp.sus[emat_x].vs[Chi::E::LIW] == 0
+        ? "++mu_perp_i"
+        : std::string("mu_perp_i += MACRO_TILE_LENGTH_") + X + "/MICRO_" + X + "_TILE_PERP_UNROLL";
 
     append_loop_var_bound_incr(ss, "mu_perp_i", bound_string, increment_string, emat_x);
   }
 
-  void append_load_for_pll(Mat::E emat_x, std::stringstream& ss)
+  void append_load_for_pll(Mat::E emat_x, emit::Emitter& ss)
   {
 
     std::string bound_string =
@@ -235,10 +338,10 @@ TFLOAT previous_value; )"
     append_loop_var_bound_incr(ss, "mu_pll_i", bound_string, increment_string, emat_x);
   }
 
-  void append_final_write_element(std::stringstream& ss,
-                                  size_t             atomic_increment,
-                                  size_t             with_beta_scaling,
-                                  size_t             with_alpha_increment)
+  void append_final_write_element(emit::Emitter& ss,
+                                  size_t         atomic_increment,
+                                  size_t         with_beta_scaling,
+                                  size_t         with_alpha_increment)
   {
 
     std::string dima_index = hp.sus[Mat::E::A].vs[Chi::E::MIW] == 0
@@ -251,6 +354,12 @@ TFLOAT previous_value; )"
     // a good place to break kernel to check error checking.
     // make this* 1.11101242345 for example
 
+    if (dp.main_c_vector_width > 1)
+    {
+      append_final_write_vector(ss, dima_index, dimb_index, with_beta_scaling, with_alpha_increment);
+      return;
+    }
+
     std::string alpha_scaled = "alpha*rC[" + dima_index + "][" + dimb_index + "]";
     ss << "\nindex =  STRIDE_PLL_M_C*(write_start_a + dima) + STRIDE_PLL_N_C*(write_start_b + "
           "dimb) ;\n";
@@ -282,7 +391,48 @@ TFLOAT previous_value; )"
     }
   }
 
-  void append_for_loops_for_c_write_open(std::stringstream& ss)
+  // Writes the C_VECTOR_WIDTH elements from (dima, dimb) along the coalesced dimension of C
+  // with one vload and one vstore. Not used with atomics.
+  void append_final_write_vector(emit::Emitter&     ss,
+                                 const std::string& dima_index,
+                                 const std::string& dimb_index,
+                                 size_t             with_beta_scaling,
+                                 size_t             with_alpha_increment)
+  {
+    size_t      width = dp.main_c_vector_width;
+    std::string vload = "vload" + std::to_string(width);
+
+    ss << "\nindex =  STRIDE_PLL_M_C*(write_start_a + dima) + STRIDE_PLL_N_C*(write_start_b + "
+          "dimb) ;\n";
+    ss << "{\nTVFLOATC c_vec;\n";
+    for (size_t j = 0; j < width; ++j)
+    {
+      std::string j_str = " + " + std::to_string(j);
+      ss << "c_vec.s" << j << " = ";
+      if (with_alpha_increment != 0)
+      {
+        ss << "alpha*rC["
+           << (dp.main_c_vector_emat == Mat::E::A ? dima_index + j_str : dima_index) << "]["
+           << (dp.main_c_vector_emat == Mat::E::B ? dimb_index + j_str : dimb_index) << "];\n";
+      }
+      else
+      {
+        ss << "0;\n";
+      }
+    }
+
+    if (with_beta_scaling != 0)
+    {
+      ss << "if (!(beta >= 0 && beta <= 0)){\nc_vec += " << vload << "(0, c + index)*beta;\n}\n";
+    }
+    else
+    {
+      ss << "c_vec += " << vload << "(0, c + index);\n";
+    }
+    ss << "vstore" << width << "(c_vec, 0, c + index);\n}\n";
+  }
+
+  void append_for_loops_for_c_write_open(emit::Emitter& ss)
   {
 
     ss << "\n/* loops for writing to c */\n";
@@ -310,8 +460,12 @@ TFLOAT previous_value; )"
       char        x     = Mat::M().lcase_name[emat];
       std::string dimxi = "dim" + std::string(1, x) + "i";
 
+      // one vector covers the VEW_X elements in the coalesced dimension of C
+      std::string increment_string = (dp.main_c_vector_width > 1 && emat == dp.main_c_vector_emat)
+                                       ? dimxi + "_v += C_VECTOR_WIDTH"
+                                       : "++" + dimxi + "_v";
       ss << dp.pragma_unroll_string;
-      append_loop_var_bound_incr(ss, dimxi + "_v", "VEW_" + X, "++" + dimxi + "_v", emat);
+      append_loop_var_bound_incr(ss, dimxi + "_v", "VEW_" + X, increment_string, emat);
       ss << " {\n";
     }
 
@@ -319,9 +473,9 @@ TFLOAT previous_value; )"
     ss << "TINTA dima = dimai*VEW_A + dimai_v;\n";
   }
 
-  void append_for_loops_for_c_write_close(std::stringstream& ss) { ss << "\n}\n}\n}\n}\n"; }
+  void append_for_loops_for_c_write_close(emit::Emitter& ss) { ss << "\n}\n}\n}\n}\n"; }
 
-  void append_check_wrapped_if_clause_open(std::stringstream& ss)
+  void append_check_wrapped_if_clause_open(emit::Emitter& ss)
   {
     ss <<
       R"(
@@ -347,13 +501,13 @@ write_start_a + dima >= MACRO_TILE_LENGTH_A*(N_GROUPS_A - 1)
 )";
   }
 
-  void append_check_wrapped_if_clause_close(std::stringstream& ss) { ss << "\n}"; }
+  void append_check_wrapped_if_clause_close(emit::Emitter& ss) { ss << "\n}"; }
 
-  void append_checked_wrapped_loops_from_bools(std::stringstream& ss,
-                                               size_t             with_check,
-                                               size_t             atomic_increment,
-                                               size_t             with_beta_scaling,
-                                               size_t             with_alpha_increment)
+  void append_checked_wrapped_loops_from_bools(emit::Emitter& ss,
+                                               size_t         with_check,
+                                               size_t         atomic_increment,
+                                               size_t         with_beta_scaling,
+                                               size_t         with_alpha_increment)
   {
 
     append_for_loops_for_c_write_open(ss);
@@ -371,9 +525,10 @@ write_start_a + dima >= MACRO_TILE_LENGTH_A*(N_GROUPS_A - 1)
     append_for_loops_for_c_write_close(ss);
   }
 
-  void append_final_write_loops(std::stringstream& ss, size_t with_check)
+  void append_final_write_loops(emit::Emitter& ss, size_t with_check)
   {
-    if (dp.main_split_on_k == 0)
+    // with stream-K, several work groups can increment the same tile of C
+    if (dp.main_split_on_k == 0 && dp.main_stream_k == 0)
     {
       append_checked_wrapped_loops_from_bools(ss, with_check, 0, 1, 1);
     }
@@ -384,28 +539,28 @@ write_start_a + dima >= MACRO_TILE_LENGTH_A*(N_GROUPS_A - 1)
     }
   }
 
-  void append_final_write_loops_no_check(std::stringstream& ss) { append_final_write_loops(ss, 0); }
+  void append_final_write_loops_no_check(emit::Emitter& ss) { append_final_write_loops(ss, 0); }
 
-  void append_final_write_loops_with_check(std::stringstream& ss)
+  void append_final_write_loops_with_check(emit::Emitter& ss)
   {
     append_final_write_loops(ss, 1);
   }
 
-  void append_k_remaining_string(std::stringstream& ss)
+  void append_k_remaining_string(emit::Emitter& ss)
   {
     ss << '\n' << "TSHORT k_remaining = " << dp.effective_k_varies_string << " % UNROLL;";
   }
 
   // simple for loops. Could consider unrolling like Cobalt, but for the moment
   // I use the optional pragma unroll
-  void append_load_ab_into_LDS_string(std::stringstream& ss,
-                                      size_t             final_unroll,
-                                      size_t             special_first_unroll)
+  void append_load_ab_into_LDS_string(emit::Emitter& ss,
+                                      size_t         final_unroll,
+                                      size_t         special_first_unroll)
   {
 
     for (auto emat : mata_matb)
     {
-      append_load_into_LDS_string(emat, ss, final_unroll, special_first_unroll);
+      append_load_into_LDS_string(emat, ss, final_unroll, special_first_unroll, "");
     }
 
     ss <<
@@ -415,11 +570,13 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
   }
 
   // simple for loops. Could consider unrolling like Cobalt,
-  // but for the moment I use the optional pragma unroll
+  // but for the moment I use the optional pragma unroll.
+  // The destination is local{A,B}, followed by lds_suffix (see append_double_buffered_loop).
   void append_load_into_LDS_string(Mat::E             emat_x,
-                                   std::stringstream& ss,
+                                   emit::Emitter&     ss,
                                    size_t             final_unroll,
-                                   size_t             special_first_unroll)
+                                   size_t             special_first_unroll,
+                                   const std::string& lds_suffix)
   {
 
     char X = Mat::M().name[emat_x];
@@ -439,37 +596,37 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
                        "broken alg, come and sort it out");
     }
 
-    std::stringstream ss_value_to_get;
-    std::stringstream ss_comment;
+    std::string value_to_get;
+    std::string comment;
 
-    std::stringstream basic_to_get_ss;
-    basic_to_get_ss << x << "_vec[(mu_pll_i*STRIDE_PLL_K_" << X << " + VEW_" << X
-                    << "*mu_perp_i*STRIDE_PERP_K_" << X << ")/VEW_" << X << "]";
+    std::string basic_to_get = get_global_load_string(
+      emat_x,
+      std::string("(mu_pll_i*STRIDE_PLL_K_") + X + " + VEW_" + X + "*mu_perp_i*STRIDE_PERP_K_" + X +
+        ")/VEW_" + X);
 
     if (final_unroll == 1 || special_first_unroll == 1)
     {
       std::string condition       = final_unroll == 1 ? " < k_remaining " : " >= unroll_offset";
       std::string special_comment = final_unroll == 1 ? "(ignoring tail)" : "(ignoring prepend)";
-      ss_comment << "/* load final bit of data from " << x << " into LDS, less than a full unroll "
-                 << special_comment << " */";
-      ss_value_to_get << "(" << x << "_offset_pll_unroll + mu_pll_i) " << condition << " ? "
-                      << basic_to_get_ss.str() << " : 0;";
+      comment = std::string("/* load final bit of data from ") + x +
+                " into LDS, less than a full unroll " + special_comment + " */";
+      value_to_get = std::string("(") + x + "_offset_pll_unroll + mu_pll_i) " + condition + " ? " +
+                     basic_to_get + " : 0;";
     }
 
     else
     {
-      ss_comment << "/* load data from " << x << " into LDS */";
-      ss_value_to_get << basic_to_get_ss.str() << ';';
+      comment      = std::string("/* load data from ") + x + " into LDS */";
+      value_to_get = basic_to_get + ';';
     }
 
-    ss << '\n' << ss_comment.str() << '\n' << dp.pragma_unroll_string;
+    ss << '\n' << comment << '\n' << dp.pragma_unroll_string;
     append_load_for_perp(emat_x, ss);
     ss << " {\n" << dp.pragma_unroll_string;
     append_load_for_pll(emat_x, ss);
     ss << " {\n"
-       << "local" << X << "[MACRO_TILE_LENGTH_" << X << "_AND_PAD/VEW_" << X << "*(" << x
-       << "_offset_pll_unroll + mu_pll_i) + " << x << "_offset_perp_unroll_v + mu_perp_i] = \n"
-       << ss_value_to_get.str() << '\n'
+       << get_lds_store_string(emat_x, lds_suffix) << " = \n"
+       << value_to_get << '\n'
        << "}\n"
        << "}\n";
 
@@ -480,6 +637,22 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
     ss << '\n';
   }
 
+  // The element of LDS written at (mu_pll_i, mu_perp_i) when loading an unroll. With SWZ, the
+  // column is XORed with the low bits of the row (see append_load_to_register_string).
+  std::string get_lds_store_string(Mat::E emat_x, const std::string& lds_suffix)
+  {
+    std::string X(1, Mat::M().name[emat_x]);
+    std::string x(1, Mat::M().lcase_name[emat_x]);
+    std::string row    = "(" + x + "_offset_pll_unroll + mu_pll_i)";
+    std::string column = x + "_offset_perp_unroll_v + mu_perp_i";
+    if (hp.sus[emat_x].vs[Chi::E::SWZ] == Binary::E::YES)
+    {
+      column = "((" + column + ") ^ (" + row + " & SWIZZLE_MASK_" + X + "))";
+    }
+    return "local" + X + lds_suffix + "[MACRO_TILE_LENGTH_" + X + "_AND_PAD/VEW_" + X + "*" + row +
+           " + " + column + "]";
+  }
+
   std::string get_c_work_item_next(Mat::E emat_x)
   {
 
@@ -490,7 +663,7 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
 
   // We previously had a variable unroll_the_math_section = False.
   // Experiments with unroll_the_math_section suggest that it's a bad idea.
-  void append_math_section(std::stringstream& ss, size_t use_k_remaining)
+  void append_math_section(emit::Emitter& ss, size_t use_k_remaining)
   {
 
     std::string number_of_unrolls = use_k_remaining == 0 ? "UNROLL" : "k_remaining";
@@ -507,32 +680,230 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
     ss << "}\n";
   }
 
-  void append_relocate_load_math_string(std::stringstream& ss,
-                                        size_t             final_unroll,
-                                        size_t             special_first_unroll)
+  // The index into pf{A,B} of the element loaded at (mu_pll_i, mu_perp_i).
+  std::string get_prefetch_index(Mat::E emat_x)
   {
-    if (final_unroll != 0 && special_first_unroll != 0)
+    std::string X(1, Mat::M().name[emat_x]);
+    std::string n_perp = "(MICRO_" + X + "_TILE_PERP_UNROLL/VEW_" + X + ")";
+    if (hp.sus[emat_x].vs[Chi::E::LIW] == 0)
     {
-      throw miog_error("From get_relocate_load_math_string : It is not "
-                       "possible for this to be "
-                       "both a `special_first_unroll' and a `final_unroll'. "
-                       "This is a logic error, "
-                       "broken alg, come and sort it out");
+      return "mu_pll_i*" + n_perp + " + mu_perp_i";
     }
+    return "(mu_pll_i/(UNROLL/MICRO_" + X + "_TILE_PLL_UNROLL))*" + n_perp +
+           " + mu_perp_i/(MACRO_TILE_LENGTH_" + X + "/MICRO_" + X + "_TILE_PERP_UNROLL)";
+  }
 
-    append_load_ab_into_LDS_string(ss, final_unroll, special_first_unroll);
+  void append_prefetch_registers_declaration(emit::Emitter& ss)
+  {
+    ss << "\n\n/* registers holding the next unroll, loaded from global memory before the maths on "
+          "the current unroll, and stored to LDS after it */";
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      ss << "\nTVFLOAT" << X << " pf" << X << "[MICRO_" << X << "_TILE_PLL_UNROLL*MICRO_" << X
+         << "_TILE_PERP_UNROLL/VEW_" << X << "];";
+    }
+  }
+
+  // As append_load_into_LDS_string, but the destination is pf{A,B}.
+  void append_load_into_registers_string(Mat::E emat_x, emit::Emitter& ss)
+  {
+    char X = Mat::M().name[emat_x];
+    char x = Mat::M().lcase_name[emat_x];
+
+    std::string n_jumps_string =
+      (dp.main_split_on_k == 0 || (hp.sus[Mat::E::C].vs[NonChi::E::IWI] == Binary::E::NO))
+        ? "UNROLL"
+        : "G_UNROLL";
+
+    ss << "\n/* prefetch data from " << x << " into registers */\n" << dp.pragma_unroll_string;
+    append_load_for_perp(emat_x, ss);
+    ss << " {\n" << dp.pragma_unroll_string;
+    append_load_for_pll(emat_x, ss);
+    ss << " {\n"
+       << "pf" << X << "[" << get_prefetch_index(emat_x) << "] = "
+       << get_global_load_string(emat_x,
+                                 std::string("(mu_pll_i*STRIDE_PLL_K_") + X + " + VEW_" + X +
+                                   "*mu_perp_i*STRIDE_PERP_K_" + X + ")/VEW_" + X)
+       << ";\n"
+       << "}\n"
+       << "}\n"
+       << x << "_vec += (STRIDE_PLL_K_" << X << "*" << n_jumps_string << ")/VEW_" << X << ";\n";
+  }
+
+  void append_registers_into_LDS_string(Mat::E             emat_x,
+                                        emit::Emitter&     ss,
+                                        const std::string& lds_suffix)
+  {
+    char X = Mat::M().name[emat_x];
+    char x = Mat::M().lcase_name[emat_x];
+
+    ss << "\n/* store the prefetched " << x << " into LDS */\n" << dp.pragma_unroll_string;
+    append_load_for_perp(emat_x, ss);
+    ss << " {\n" << dp.pragma_unroll_string;
+    append_load_for_pll(emat_x, ss);
+    ss << " {\n"
+       << get_lds_store_string(emat_x, lds_suffix) << " = pf" << X << "["
+       << get_prefetch_index(emat_x) << "];\n"
+       << "}\n"
+       << "}\n";
+  }
+
+  // With PFR (and not DBL), the global loads of the next unroll are issued before the maths
+  // on the current unroll, and only stored to LDS once the maths is complete.
+  void append_register_prefetched_loop(emit::Emitter& ss)
+  {
+    append_prefetch_registers_declaration(ss);
+
+    ss << "\n\n/* the first unroll */\nif (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      append_load_into_registers_string(emat_x, ss);
+    }
+    ss << "}\n";
+
+    ss << "\nwhile (n_unrolls_remaining > 0){\n--n_unrolls_remaining;\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      append_registers_into_LDS_string(emat_x, ss, "");
+    }
+    ss << R"(
+/* make sure all stores to LDS have completed */
+barrier(CLK_LOCAL_MEM_FENCE);
+)";
+
+    ss << "\n/* the next unroll, into registers */\nif (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      append_load_into_registers_string(emat_x, ss);
+    }
+    ss << "}\n";
 
+    append_relocate_string(ss, "");
     ss << '\n';
+    append_math_section(ss, 0);
+    ss << R"(
+/* make sure all maths is complete, so that the next unroll can be stored to LDS */
+barrier(CLK_LOCAL_MEM_FENCE);
+}
+)";
+  }
+
+  void append_relocate_string(emit::Emitter& ss, const std::string& lds_suffix)
+  {
     for (Mat::E emat_x : mata_matb)
     {
       char X = Mat::M().name[emat_x];
       char x = Mat::M().lcase_name[emat_x];
 
-      ss << '\n'
-         << "l" << X << " = local" << X << " + micro_id_" << x << "*"
-         << get_c_work_item_next(emat_x) << "/VEW_" << X << ";";
+      // with SWZ, the column offset of the work item is applied when reading
+      ss << '\n' << "l" << X << " = local" << X << lds_suffix;
+      if (hp.sus[emat_x].vs[Chi::E::SWZ] == Binary::E::NO)
+      {
+        ss << " + micro_id_" << x << "*" << get_c_work_item_next(emat_x) << "/VEW_" << X;
+      }
+      ss << ";";
+    }
+  }
+
+  // With DBL, the unroll tiles alternate between two LDS buffers : the tiles of the next
+  // unroll are loaded into one while the maths is done on the other, so that the global
+  // loads overlap with the maths, and there is one barrier per unroll instead of two.
+  // With PFR as well, the next unroll is loaded into registers before the maths, and stored
+  // into the other buffer after it.
+  void append_double_buffered_loop(emit::Emitter& ss)
+  {
+    bool prefetch = dp.main_n_prefetch_registers != 0;
+    if (prefetch)
+    {
+      append_prefetch_registers_declaration(ss);
+    }
+
+    ss << "\n\n/* LDS double buffering : the maths is done on the _math buffers, while the next "
+          "unroll is loaded into the _load buffers */";
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      ss << "\n__local TVFLOAT" << X << " * local" << X << "_math = local" << X << ";"
+         << "\n__local TVFLOAT" << X << " * local" << X << "_load = local" << X
+         << " + N_ELEMENTS_IN_PADDED_" << X << "_UNROLL/VEW_" << X << ";";
+    }
+
+    ss << "\n\n/* the first unroll */\nif (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      if (prefetch)
+      {
+        append_load_into_registers_string(emat_x, ss);
+        append_registers_into_LDS_string(emat_x, ss, "_math");
+      }
+      else
+      {
+        append_load_into_LDS_string(emat_x, ss, 0, 0, "_math");
+      }
     }
+    ss << "}\nbarrier(CLK_LOCAL_MEM_FENCE);\n";
 
+    ss << "\nwhile (n_unrolls_remaining > 0){\n--n_unrolls_remaining;\n";
+    ss << "\n/* the next unroll, into the buffers not being read */\nif (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      if (prefetch)
+      {
+        append_load_into_registers_string(emat_x, ss);
+      }
+      else
+      {
+        append_load_into_LDS_string(emat_x, ss, 0, 0, "_load");
+      }
+    }
+    ss << "}\n";
+
+    append_relocate_string(ss, "_math");
+    ss << '\n';
+    append_math_section(ss, 0);
+
+    if (prefetch)
+    {
+      ss << "\nif (n_unrolls_remaining > 0){\n";
+      for (Mat::E emat_x : mata_matb)
+      {
+        append_registers_into_LDS_string(emat_x, ss, "_load");
+      }
+      ss << "}\n";
+    }
+
+    ss << R"(
+/* make sure the next unroll is loaded, and all maths on the current is complete */
+barrier(CLK_LOCAL_MEM_FENCE);
+)";
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      ss << "{\n__local TVFLOAT" << X << " * swap = local" << X << "_math;\n"
+         << "local" << X << "_math = local" << X << "_load;\n"
+         << "local" << X << "_load = swap;\n}\n";
+    }
+    ss << "}\n";
+  }
+
+  void append_relocate_load_math_string(emit::Emitter& ss,
+                                        size_t         final_unroll,
+                                        size_t         special_first_unroll)
+  {
+    if (final_unroll != 0 && special_first_unroll != 0)
+    {
+      throw miog_error("From get_relocate_load_math_string : It is not "
+                       "possible for this to be "
+                       "both a `special_first_unroll' and a `final_unroll'. "
+                       "This is a logic error, "
+                       "broken alg, come and sort it out");
+    }
+
+    append_load_ab_into_LDS_string(ss, final_unroll, special_first_unroll);
+
+    ss << '\n';
+    append_relocate_string(ss, "");
     ss << '\n';
 
     append_math_section(ss, final_unroll);
@@ -542,7 +913,7 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
 barrier(CLK_LOCAL_MEM_FENCE); )";
   }
 
-  void append_final_unroll_string(std::stringstream& ss)
+  void append_final_unroll_string(emit::Emitter& ss)
   {
 
     if (dp.main_split_on_k == 0)
@@ -578,7 +949,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
   }
 
-  void append_first_unroll_block(std::stringstream& ss)
+  void append_first_unroll_block(emit::Emitter& ss)
   {
     if (hp.sus[Mat::E::C].vs[NonChi::E::UFO] != 0)
     {
@@ -600,7 +971,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
   }
 
-  void append_compute_string(std::stringstream& ss)
+  void append_compute_string(emit::Emitter& ss)
   {
 
     for (auto emat : mata_matb)
@@ -621,9 +992,19 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
   }
 
-  void append_load_to_register_string(Mat::E emat_x, std::stringstream& ss)
+  // lX is at the start of row u of the unroll. With SWZ, the column is swizzled as in
+  // get_lds_store_string, and the work item's column offset is included here.
+  void append_load_to_register_string(Mat::E emat_x, emit::Emitter& ss)
   {
     char X = Mat::M().name[emat_x];
+    char x = Mat::M().lcase_name[emat_x];
+
+    std::string index = std::string("i*C_INTERWEAVE_STRIDE_") + X;
+    if (hp.sus[emat_x].vs[Chi::E::SWZ] == Binary::E::YES)
+    {
+      index = std::string("(micro_id_") + x + "*" + get_c_work_item_next(emat_x) + "/VEW_" + X +
+              " + " + index + ") ^ (u & SWIZZLE_MASK_" + X + ")";
+    }
 
     ss << '\n' << dp.pragma_unroll_string;
     ss << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_" << X << "/VEW_" << X << "; ++i){\n";
@@ -632,21 +1013,20 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     {
       for (unsigned j = 0; j < hp.sus[emat_x].vs[Chi::E::VEW]; ++j)
       {
-        ss << "r" << X << "[VEW_" << X << "*i + " << j << "] = l" << X << "["
-           << "i*"
-           << "C_INTERWEAVE_STRIDE_" << X << "].s" << j << ";\n";
+        ss << "r" << X << "[VEW_" << X << "*i + " << j << "] = l" << X << "[" << index << "].s" << j
+           << ";\n";
       }
     }
     else
     {
-      ss << "r" << X << "[i] = l" << X << "[i*C_INTERWEAVE_STRIDE_" << X << "];\n";
+      ss << "r" << X << "[i] = l" << X << "[" << index << "];\n";
     }
     ss << "}\n";
 
     ss << "l" << X << " += MACRO_TILE_LENGTH_" << X << "_AND_PAD/VEW_" << X << ";\n";
   }
 
-  void append_group_allocation_defn_string(std::stringstream& ss)
+  void append_group_allocation_defn_string(emit::Emitter& ss)
   {
     ss << "#define GROUP_ALLOCATION " << hp.sus[Mat::E::C].vs[NonChi::E::GAL] << '\n';
     if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == 3)
@@ -660,7 +1040,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
   }
 
-  void append_final_write_all(std::stringstream& ss)
+  void append_final_write_all(emit::Emitter& ss)
   {
 
     if (dp.main_use_edge_trick == 0)
@@ -681,9 +1061,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
         cond_ab[emat] = "";
         if (dp.at(emat).preshift_final_tile != dp.at(emat).macro_tile_length)
         {
-          std::stringstream soo;
-          soo << "(group_id_" << x << " != N_GROUPS_" << X << " - 1)";
-          cond_ab[emat] = soo.str();
+          cond_ab[emat] = std::string("(group_id_") + x + " != N_GROUPS_" + X + " - 1)";
           ++nconds;
         }
       }
@@ -730,7 +1108,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
   }
 
-  void append_split_on_k_defns_string(std::stringstream& ss)
+  void append_split_on_k_defns_string(emit::Emitter& ss)
   {
     if (dp.main_split_on_k != 0)
     {
@@ -743,9 +1121,29 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
   }
 
-  void append_group_id_defns(std::stringstream& ss)
+  void append_stream_k_defns_string(emit::Emitter& ss)
   {
-    if (dp.main_split_on_k == 0)
+    if (dp.main_stream_k != 0)
+    {
+      ss << "\n/* stream-K : the N_WORK_GROUPS work groups share the N_STREAM_K_UNITS (macro tile, "
+            "unroll) work units, */\n/* each processing a contiguous range of them. C is "
+            "incremented atomically, after being scaled by beta in a separate kernel */\n";
+      ss << "#define N_UNROLLS_PER_TILE " << gg.k / hp.sus[Mat::E::C].vs[NonChi::E::UNR] << '\n';
+      ss << "#define N_STREAM_K_UNITS " << dp.main_n_stream_k_units << '\n';
+    }
+  }
+
+  void append_group_id_defns(emit::Emitter& ss)
+  {
+    if (dp.main_stream_k != 0)
+    {
+      ss << R"(
+/* the macro tile of the work unit sk_unit, and its unroll within the tile */
+const TINTC group_id_xy = sk_unit / N_UNROLLS_PER_TILE;
+const TINTK sk_first_unroll = sk_unit % N_UNROLLS_PER_TILE;
+)";
+    }
+    else if (dp.main_split_on_k == 0)
     {
       ss << "\nconst TINTC group_id_xy = get_group_id(0);\n";
     }
@@ -760,7 +1158,7 @@ const TSHORT group_id_z = group_id % N_WORK_ITEMS_PER_C_ELM;
     }
   }
 
-  void append_stride_c_defn(std::stringstream& ss)
+  void append_stride_c_defn(emit::Emitter& ss)
   {
 
     size_t transposed_xor_is_col_major = (gg.tX[Mat::E::C] + gg.isColMajor) % 2;
@@ -770,10 +1168,18 @@ const TSHORT group_id_z = group_id % N_WORK_ITEMS_PER_C_ELM;
        << '\n';
   }
 
-  void append_n_unrolls_remaining_string(std::stringstream& ss)
+  void append_n_unrolls_remaining_string(emit::Emitter& ss)
   {
 
-    if (dp.main_split_on_k == 0)
+    if (dp.main_stream_k != 0)
+    {
+      ss << R"(
+/* the work units of this work group in this macro tile */
+int n_unrolls_remaining = min((ulong)(N_UNROLLS_PER_TILE - sk_first_unroll), sk_unit_end - sk_unit);
+sk_unit += n_unrolls_remaining;)";
+    }
+
+    else if (dp.main_split_on_k == 0)
     {
       ss << "\nint n_unrolls_remaining = " << dp.k_effective_div_UNROLL << ";";
     }
@@ -792,7 +1198,7 @@ const TSHORT group_id_z = group_id % N_WORK_ITEMS_PER_C_ELM;
     }
   }
 
-  void append_c_offset_string(std::stringstream& ss)
+  void append_c_offset_string(emit::Emitter& ss)
   {
 
     ss << R"(
@@ -806,7 +1212,41 @@ c += c_offset;
 )";
   }
 
-  void append_id_string_nonsym(std::stringstream& ss)
+  // Opens the loop over the work units of the work group. The LDS is declared before it, at
+  // kernel scope, and a and b are returned to their starting positions at each iteration.
+  void append_stream_k_open_string(emit::Emitter& ss)
+  {
+    ss << '\n';
+    for (auto emat : mata_matb)
+    {
+      append_lds_declaration(ss, emat);
+    }
+    for (auto emat : mata_matb)
+    {
+      if (hp.sus[emat].vs[Chi::E::WOS] == Scratch::E::UNUSED)
+      {
+        char x = Mat::M().lcase_name[emat];
+        ss << "const __global TFLOAT * const " << x << "_sk = " << x << ";\n";
+      }
+    }
+
+    ss << R"(
+/* stream-K : this work group processes the work units [sk_unit, sk_unit_end) */
+ulong sk_unit = (get_group_id(0)*(ulong)N_STREAM_K_UNITS)/N_WORK_GROUPS;
+const ulong sk_unit_end = ((get_group_id(0) + 1)*(ulong)N_STREAM_K_UNITS)/N_WORK_GROUPS;
+while (sk_unit < sk_unit_end){
+)";
+    for (auto emat : mata_matb)
+    {
+      if (hp.sus[emat].vs[Chi::E::WOS] == Scratch::E::UNUSED)
+      {
+        char x = Mat::M().lcase_name[emat];
+        ss << x << " = " << x << "_sk;\n";
+      }
+    }
+  }
+
+  void append_id_string_nonsym(emit::Emitter& ss)
   {
     ss << "const TSHORT local_id = (TSHORT)(get_local_id(0));\n";
     append_group_id_defns(ss);
@@ -848,7 +1288,17 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     }
   }
 
-  void append_id_string_sym(std::stringstream& ss, Mat::E emat_x)
+  void append_lds_declaration(emit::Emitter& ss, Mat::E emat_x)
+  {
+    char X = Mat::M().name[emat_x];
+    if (emat_x == Mat::E::A)
+      ss << "/* LDS memory */\n";
+    ss << "__local "
+       << "TVFLOAT" << X << " local" << X << "[N_LDS_BUFFERS*N_ELEMENTS_IN_PADDED_" << X
+       << "_UNROLL/VEW_" << X << "];\n";
+  }
+
+  void append_id_string_sym(emit::Emitter& ss, Mat::E emat_x)
   {
 
     char X = Mat::M().name[emat_x];
@@ -856,11 +1306,11 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     ss << '\n';
 
-    if (emat_x == Mat::E::A)
-      ss << "/* LDS memory */\n";
-    ss << "__local "
-       << "TVFLOAT" << X << " local" << X << "[N_ELEMENTS_IN_PADDED_" << X << "_UNROLL"
-       << "/VEW_" << X << "];\n";
+    // with stream-K, the LDS is declared at kernel scope, before the loop over work units
+    if (dp.main_stream_k == 0)
+    {
+      append_lds_declaration(ss, emat_x);
+    }
     if (emat_x == Mat::E::A)
       ss << "/* jumping pointer to locate the LDS to load into register memory "
             "*/\n";
@@ -901,6 +1351,14 @@ TINTK k_plus_offset = KV__ + unroll_offset;
       ss << x << " += " << x << "_offset;\n";
     }
 
+    std::string xn = get_navigator(emat_x);
+    if (is_implicit(emat_x))
+    {
+      ss << "/* " << x << " is implicit : the pointer " << x << " stays at the image, " << xn
+         << " is the index into the virtual " << X << " */\n";
+      ss << "TINT" << X << " " << xn << " = 0;\n";
+    }
+
     if (emat_x == Mat::E::A)
       ss << "/* Define what of A this thread will load from unroll tile in "
             "global to LDS (% / or / "
@@ -929,7 +1387,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     if (emat_x == Mat::E::A)
       ss << "/* move to corner of the region required by the macro tile */\n";
-    ss << x << " += read_macro_tile_start_" << x << "*MACRO_STRIDE_PERP_K_" << X << ";\n";
+    ss << xn << " += read_macro_tile_start_" << x << "*MACRO_STRIDE_PERP_K_" << X << ";\n";
 
     if (dp.main_split_on_k != 0)
     {
@@ -943,14 +1401,14 @@ TINTK k_plus_offset = KV__ + unroll_offset;
         {
           ss << "/* IWI is NO, ICE is not interwoven */\n";
         }
-        ss << x << " += (1 + (" << dp.k_effective_div_G_UNROLL
+        ss << xn << " += (1 + (" << dp.k_effective_div_G_UNROLL
            << "))*UNROLL*group_id_z*STRIDE_PLL_K_" << X << ";\n";
         if (emat_x == Mat::E::A)
         {
           ss << "/*The last couple of groups (large group_id_z) will process 1 fewer unroll */\n";
         }
         ss << "\nif (group_id_z >  n_work_groups_with_1_more){\n";
-        ss << x << " -= UNROLL*(group_id_z - n_work_groups_with_1_more)*STRIDE_PLL_K_" << X
+        ss << xn << " -= UNROLL*(group_id_z - n_work_groups_with_1_more)*STRIDE_PLL_K_" << X
            << ";\n}\n";
       }
       else if (hp.sus[Mat::E::C].vs[NonChi::E::IWI] == Binary::E::YES)
@@ -959,7 +1417,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
         {
           ss << "/* IWI is YES, ICE is interwoven */\n";
         }
-        ss << x << " += UNROLL*group_id_z*STRIDE_PLL_K_" << X << ";\n";
+        ss << xn << " += UNROLL*group_id_z*STRIDE_PLL_K_" << X << ";\n";
       }
       else
       {
@@ -970,6 +1428,15 @@ TINTK k_plus_offset = KV__ + unroll_offset;
       }
     }
 
+    if (dp.main_stream_k != 0)
+    {
+      if (emat_x == Mat::E::A)
+      {
+        ss << "/* stream-K : move to the first unroll of the work units */\n";
+      }
+      ss << xn << " += UNROLL*sk_first_unroll*STRIDE_PLL_K_" << X << ";\n";
+    }
+
     if (hp.sus[Mat::E::C].vs[NonChi::E::UFO] != 0)
     {
       if (emat_x == Mat::E::A)
@@ -977,7 +1444,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
         ss << "/* UFO != 0, so offsetting the unroll */\n";
       }
 
-      ss << x << " -= unroll_offset*STRIDE_PLL_K_" << X << ";\n";
+      ss << xn << " -= unroll_offset*STRIDE_PLL_K_" << X << ";\n";
     }
 
     std::string str_n_pll("");
@@ -1003,7 +1470,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << "const TINT" << X << " " << x << "_offset_perp_unroll_v = " << str_n_perp_v
        << " perp_unroll_" << x << "_load_id;\n";
 
-    ss << x << " += "
+    ss << xn << " += "
        << "STRIDE_PLL_K_" << X << " * " << x << "_offset_pll_unroll;\n";
 
     if (emat_x == Mat::E::A)
@@ -1011,8 +1478,15 @@ TINTK k_plus_offset = KV__ + unroll_offset;
       ss << "/* vectorised version of a */\n";
     }
 
-    ss << "const __global TVFLOAT" << X << " * " << x << "_vec = (const __global TVFLOAT" << X
-       << " * )" << x << ";\n";
+    if (is_implicit(emat_x))
+    {
+      ss << "TINT" << X << " " << x << "_vec = " << xn << ";\n";
+    }
+    else
+    {
+      ss << "const __global TVFLOAT" << X << " * " << x << "_vec = (const __global TVFLOAT" << X
+         << " * )" << x << ";\n";
+    }
 
     ss << x << "_vec += "
        << "STRIDE_PERP_K_" << X << " * " << x << "_offset_perp_unroll_v;\n";
@@ -1020,7 +1494,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << '\n';
   }
 
-  void append_transpose_note(std::stringstream& ss)
+  void append_transpose_note(emit::Emitter& ss)
   {
     ss << R"(
 /* A note on how transposes isColMajor  effect the kernel generated: very little. */
@@ -1028,7 +1502,71 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 )";
   }
 
-  void add_predefine_chiral(Mat::E emat_x, std::stringstream& ss)
+  // Whether x is the implicit im2col matrix of a convolution (see Convolution)
+  bool is_implicit(Mat::E emat_x) const { return emat_x == Mat::E::B && gg.conv.is_set(); }
+
+  // The variable moved through x while loading it : the pointer x, or with implicit x the index
+  // x_i into the virtual matrix, the pointer x remaining at the image.
+  std::string get_navigator(Mat::E emat_x) const
+  {
+    std::string x(1, Mat::M().lcase_name[emat_x]);
+    return is_implicit(emat_x) ? x + "_i" : x;
+  }
+
+  // The value of x_vec at index, read from global memory.
+  std::string get_global_load_string(Mat::E emat_x, const std::string& index)
+  {
+    std::string x(1, Mat::M().lcase_name[emat_x]);
+    if (is_implicit(emat_x))
+    {
+      return "get_implicit_" + x + "(" + x + ", " + x + "_vec + " + index + ")";
+    }
+    return x + "_vec[" + index + "]";
+  }
+
+  void append_implicit_b_defns(emit::Emitter& ss)
+  {
+    const Convolution& conv = gg.conv;
+    ss << "\n/* ********************************** implicit B "
+          "*************************************** */\n";
+    ss << "/* B is the im2col matrix of the image b, " << conv.get_string() << " */\n";
+    ss << "#define IMAGE_NHWC " << conv.nhwc << '\n';
+    ss << "#define IMAGE_C " << conv.c << '\n';
+    ss << "#define IMAGE_H " << conv.h << '\n';
+    ss << "#define IMAGE_W " << conv.w << '\n';
+    ss << "#define FILTER_R " << conv.r << '\n';
+    ss << "#define FILTER_S " << conv.s << '\n';
+    ss << "#define PAD_H " << conv.pad_h << '\n';
+    ss << "#define PAD_W " << conv.pad_w << '\n';
+    ss << "#define CONV_STRIDE_H " << conv.stride_h << '\n';
+    ss << "#define CONV_STRIDE_W " << conv.stride_w << '\n';
+    ss << "#define DILATION_H " << conv.dilation_h << '\n';
+    ss << "#define DILATION_W " << conv.dilation_w << '\n';
+    ss << "#define OUT_W " << conv.get_out_w() << '\n';
+    ss << "#define LDB_IMPLICIT " << gg.ldX[Mat::E::B] << '\n';
+    ss << R"(
+/* element i = kk + nn*LDB_IMPLICIT of B, computed from the image. The padding is offset */
+/* by PAD_H and PAD_W, so that the row and column are not negative */
+TFLOAT get_implicit_b(const __global TFLOAT * restrict image, const TINTB i){
+const TINTB kk = i % LDB_IMPLICIT;
+const TINTB nn = i / LDB_IMPLICIT;
+const TINTB c = kk / (FILTER_R*FILTER_S);
+const TINTB h_padded = (nn / OUT_W)*CONV_STRIDE_H + ((kk / FILTER_S) % FILTER_R)*DILATION_H;
+const TINTB w_padded = (nn % OUT_W)*CONV_STRIDE_W + (kk % FILTER_S)*DILATION_W;
+if (h_padded < PAD_H || h_padded >= IMAGE_H + PAD_H ||
+    w_padded < PAD_W || w_padded >= IMAGE_W + PAD_W){
+return 0;
+}
+#if IMAGE_NHWC == 1
+return image[((h_padded - PAD_H)*IMAGE_W + w_padded - PAD_W)*IMAGE_C + c];
+#else
+return image[(c*IMAGE_H + h_padded - PAD_H)*IMAGE_W + w_padded - PAD_W];
+#endif
+}
+)";
+  }
+
+  void add_predefine_chiral(Mat::E emat_x, emit::Emitter& ss)
   {
 
     char x = Mat::M().name[emat_x];
@@ -1067,7 +1605,13 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     if (emat_x == Mat::E::A)
       ss << "/* the amount of padding of " << x
          << " in LDS (local) memory, to avoid bank comflicts */\n";
-    ss << "#define PAD_LDS_" << x << "  " << hp.sus[emat_x].vs[Chi::E::PAD] << '\n';
+    ss << "#define PAD_LDS_" << x << "  "
+       << (hp.sus[emat_x].vs[Chi::E::SWZ] == Binary::E::YES ? 0 : hp.sus[emat_x].vs[Chi::E::PAD])
+       << '\n';
+    if (emat_x == Mat::E::A)
+      ss << "/* (if not 0) the LDS column of " << x
+         << " is XORed with the row & SWIZZLE_MASK, to avoid bank conflicts without padding */\n";
+    ss << "#define SWIZZLE_MASK_" << x << "  " << dp.at(emat_x).main_lds_swizzle_mask << '\n';
     if (emat_x == Mat::E::A)
       ss << "/* whether loading of " << x << " from global should try to be long in direction of "
                                              "unroll (1) or perpendicular to it (0) */\n";
@@ -1128,10 +1672,9 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
   public:
   // the "main" kernel
-  virtual KernBlob get_kernelstring() override final
+  virtual void append_kernelstring(emit::Emitter& ss) override final
   {
 
-    std::stringstream ss;
     ss << get_time_string();
     ss << "\n\n";
     ss << "/* this kernel was generated for starting geometry : */\n";
@@ -1183,6 +1726,19 @@ TINTK k_plus_offset = KV__ + unroll_offset;
           "each iteration of "
           "the outer-most loop */\n";
     ss << "#define UNROLL " << hp.sus[Mat::E::C].vs[NonChi::E::UNR] << '\n';
+    ss << "/* whether the LDS is double buffered (2) or not (1) : with 2, the next unroll is "
+          "loaded into LDS while the current is computed */\n";
+    ss << "#define N_LDS_BUFFERS " << dp.main_n_lds_buffers << '\n';
+    ss << "/* whether the next unroll is prefetched from global memory into registers while the "
+          "current is computed */\n";
+    ss << "#define PREFETCH_TO_REGISTERS " << (dp.main_n_prefetch_registers != 0) << '\n';
+    ss << "/* the number of elements of C loaded and stored together, along the coalesced "
+          "dimension of C */\n";
+    ss << "#define C_VECTOR_WIDTH " << dp.main_c_vector_width << '\n';
+    if (dp.main_c_vector_width > 1)
+    {
+      ss << "#define TVFLOATC " << dp.t_float << dp.main_c_vector_width << '\n';
+    }
     ss << "/* whether or not this kernel uses the edge trick (SC17 submission) "
           "*/\n";
     ss << "/* this precompiler defn has no direct influence on the running the "
@@ -1246,8 +1802,14 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     append_stride_c_defn(ss);
     append_split_on_k_defns_string(ss);
+    append_stream_k_defns_string(ss);
     append_super_column_width_defn(ss);
 
+    if (gg.conv.is_set())
+    {
+      append_implicit_b_defns(ss);
+    }
+
     ss << "\n\n\n__attribute__((reqd_work_group_size(" << dp.main_n_work_items_per_workgroup
        << ",1, 1)))\n";
     ss << "__kernel void ";
@@ -1258,6 +1820,11 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     append_c_offset_string(ss);
 
+    if (dp.main_stream_k != 0)
+    {
+      append_stream_k_open_string(ss);
+    }
+
     append_id_string_nonsym(ss);
 
     append_n_unrolls_remaining_string(ss);
@@ -1276,9 +1843,20 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     append_first_unroll_block(ss);
 
-    ss << "\n\nwhile (n_unrolls_remaining > 0){\n";
-    append_relocate_load_math_string(ss, 0, 0);
-    ss << "\n--n_unrolls_remaining;\n}\n";
+    if (dp.main_n_lds_buffers == 2)
+    {
+      append_double_buffered_loop(ss);
+    }
+    else if (dp.main_n_prefetch_registers != 0)
+    {
+      append_register_prefetched_loop(ss);
+    }
+    else
+    {
+      ss << "\n\nwhile (n_unrolls_remaining > 0){\n";
+      append_relocate_load_math_string(ss, 0, 0);
+      ss << "\n--n_unrolls_remaining;\n}\n";
+    }
 
     if (dp.main_final_fractional_unroll == 1)
     {
@@ -1294,14 +1872,13 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     append_split_on_k_vardecl_write_string(ss);
     append_final_write_all(ss);
 
-    ss << "\n}\n";
+    if (dp.main_stream_k != 0)
+    {
+      ss << "\n\n/* the LDS is reused by the next work units */\n"
+         << "barrier(CLK_LOCAL_MEM_FENCE);\n}\n";
+    }
 
-    return {get_ktype(),
-            {u_a, u_b, u_c, u_w, u_alpha, u_beta},
-            ss.str(),
-            kernelname,
-            dp.main_global_work_size,
-            dp.main_n_work_items_per_workgroup};
+    ss << "\n}\n";
   }
 
   virtual size_t get_local_work_size() override final { return dp.main_n_work_items_per_workgroup; }
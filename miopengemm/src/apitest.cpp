@@ -383,42 +383,18 @@ RunStats supa_gemm0(cl_command_queue&               queue,
                                       "read from device",
                                       true);
 
-      // perform GEMM on CPU
+      // perform GEMM on CPU, and in the same pass the absolute GEMM
       std::vector<T> c_cpu(c_mem0);
-      cpugemm::gemm<T>(gg,
-                       toff,
-                       ptr_cmb->r_mem[Mat::E::A],
-                       ptr_cmb->r_mem[Mat::E::B],
-                       c_cpu.data(),
-                       alpha,
-                       beta,
-                       mowri);
-
-      // perform absolute GEMM on CPU
-
-      std::vector<T> A_abs(memsize(Mat::E::A) / sizeof(T));
-      std::memcpy(A_abs.data(), ptr_cmb->r_mem[Mat::E::A], memsize(Mat::E::A));
-      for (auto& x : A_abs)
-      {
-        x = std::abs(x);
-      }
-
-      std::vector<T> B_abs(memsize(Mat::E::B) / sizeof(T));
-      std::memcpy(B_abs.data(), ptr_cmb->r_mem[Mat::E::B], memsize(Mat::E::B));
-      for (auto& x : B_abs)
-      {
-        x = std::abs(x);
-      }
-
-      std::vector<T> C_abs(memsize(Mat::E::C) / sizeof(T));
-      std::memcpy(C_abs.data(), c_mem0.data(), memsize(Mat::E::C));
-      for (auto& x : C_abs)
-      {
-        x = std::abs(x);
-      }
-
-      cpugemm::gemm<T>(
-        gg, toff, A_abs.data(), B_abs.data(), C_abs.data(), std::abs(alpha), std::abs(beta), mowri);
+      std::vector<T> C_abs(c_mem0.size());
+      cpugemm::gemm_with_abs<T>(gg,
+                                toff,
+                                ptr_cmb->r_mem[Mat::E::A],
+                                ptr_cmb->r_mem[Mat::E::B],
+                                c_cpu.data(),
+                                C_abs.data(),
+                                alpha,
+                                beta,
+                                mowri);
 
       // make sure the readevent is complete and then release it.
       oclutil::cl_wait_for_events(1, &readevent, "waiting for read from device", true);
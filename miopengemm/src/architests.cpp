@@ -27,10 +27,10 @@ Stat::Stat(const oclutil::DevInfo& devinfo,
               << " ) : cannot compile this kernel to this architecture \n";
   }
 
-  // check 0 : LDS
-  size_t LDS_required =
-    gg.derived.float_size_bytes * ((dp.at(Mat::E::A).main_n_elements_in_padded_unroll +
-                                    dp.at(Mat::E::B).main_n_elements_in_padded_unroll));
+  // check 0 : LDS, twice the unroll tiles if double buffered
+  size_t LDS_required = dp.main_n_lds_buffers * gg.derived.float_size_bytes *
+                        ((dp.at(Mat::E::A).main_n_elements_in_padded_unroll +
+                          dp.at(Mat::E::B).main_n_elements_in_padded_unroll));
 
   if (LDS_required >= devinfo.device_local_mem_size)  // max_LDS_bytes)
   {
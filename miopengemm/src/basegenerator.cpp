@@ -1,9 +1,7 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
-#include <chrono>
-#include <sstream>
-#include <sstream>
+#include <string>
 #include <miopengemm/basegenerator.hpp>
 
 namespace MIOpenGEMM
@@ -18,7 +16,19 @@ BaseGenerator::BaseGenerator(const HyPas& hp_, const Geometry& gg_, const Derive
 {
 }
 
-void BaseGenerator::append_farg(bool u_x, std::stringstream& ss, const std::string& argfrag)
+KernBlob BaseGenerator::get_kernelstring()
+{
+  emit::Emitter ss;
+  append_kernelstring(ss);
+  return {get_ktype(),
+          {u_a, u_b, u_c, u_w, u_alpha, u_beta},
+          ss.release(),
+          kernelname,
+          get_global_work_size(),
+          get_local_work_size()};
+}
+
+void BaseGenerator::append_farg(bool u_x, emit::Emitter& ss, const std::string& argfrag)
 {
   char token = n_args_added == 0 ? ' ' : ',';
   if (u_x == true)
@@ -28,28 +38,29 @@ void BaseGenerator::append_farg(bool u_x, std::stringstream& ss, const std::stri
   }
 }
 
-void BaseGenerator::append_fargs(std::stringstream& ss)
+void BaseGenerator::append_fargs(emit::Emitter& ss, const std::string& first_farg)
 {
   ss << "\n(";
+  append_farg(first_farg != "", ss, first_farg);
   append_farg(u_a, ss, "\n__global const TFLOAT * restrict a, \nconst ulong a_offset");
   append_farg(u_b, ss, "\n__global const TFLOAT * restrict b, \nconst ulong b_offset");
   append_farg(u_c, ss, "\n__global TFLOAT       *          c, \nconst ulong c_offset");
   // if using c, we assume workspace is const.
   // this is a hacky, as we might have a kernel
-  // which uses c and modifies w as well.
-  std::string cness = (u_c == true) ? "const " : "";
+  // which uses c and modifies w as well : the fused preparation kernel does.
+  std::string cness = (u_c == true && get_ktype() != KType::E::PREP) ? "const " : "";
   append_farg(u_w, ss, "\n__global " + cness + "TFLOAT * restrict w,\nconst ulong w_offset");
   append_farg(u_alpha, ss, "\nconst TFLOAT alpha");
   append_farg(u_beta, ss, "\nconst TFLOAT beta");
   ss << ")\n";
 }
 
-void BaseGenerator::append_stride_definitions(Mat::E             emat_x,
-                                              std::stringstream& ss,
-                                              size_t             workspace_type,
-                                              bool               withcomments,
-                                              std::string        macro_prefix,
-                                              bool               with_x_in_name)
+void BaseGenerator::append_stride_definitions(Mat::E         emat_x,
+                                              emit::Emitter& ss,
+                                              size_t         workspace_type,
+                                              bool           withcomments,
+                                              std::string    macro_prefix,
+                                              bool           with_x_in_name)
 {
 
   char x = Mat::M().name[emat_x];
@@ -68,10 +79,10 @@ void BaseGenerator::append_stride_definitions(Mat::E             emat_x,
   }
 }
 
-void BaseGenerator::append_unroll_block_geometry(Mat::E             emat_x,
-                                                 std::stringstream& ss,
-                                                 bool               withcomments,
-                                                 bool               with_x_string)
+void BaseGenerator::append_unroll_block_geometry(Mat::E         emat_x,
+                                                 emit::Emitter& ss,
+                                                 bool           withcomments,
+                                                 bool           with_x_string)
 {
 
   char        X        = Mat::M().name[emat_x];
@@ -122,17 +133,9 @@ void BaseGenerator::append_unroll_block_geometry(Mat::E             emat_x,
 
 std::string BaseGenerator::get_time_string()
 {
-
-  std::chrono::time_point<std::chrono::system_clock> now = std::chrono::system_clock::now();
-  std::time_t generation_time = std::chrono::system_clock::to_time_t(now);
-
-  std::stringstream ss;
-  ss << "This " << type << " kernel string was generated on " << std::ctime(&generation_time);
-
-  std::string time_stamp_string = ss.str();
-
+  // No time stamp, so that the kernel strings of a solution are always the same
+  // (a compiled program is reused when its kernel string is unchanged).
   return "";
-  // return stringutil::get_star_wrapped(time_stamp_string.substr(0, time_stamp_string.size() - 1));
 }
 
 std::string BaseGenerator::get_what_string()
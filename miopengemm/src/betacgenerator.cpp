@@ -38,11 +38,18 @@ void BetacGenerator::setup_additional()
     "\n/* beta scaling */\nif (beta <= 0 && beta >= 0){c[i] = 0;}else{c[i] *= beta;}";
 }
 
-void BetacGenerator::append_derived_definitions_additional(std::stringstream& ss) { ss << " "; }
+void BetacGenerator::append_derived_definitions_additional(emit::Emitter& ss) { ss << " "; }
 
-KernBlob get_betac_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+KernBlob get_betac_kernelstring(const HyPas&         hp,
+                                const Geometry&      gg,
+                                const DerivedParams& dp,
+                                bool                 as_fused_function)
 {
   BetacGenerator bcg(hp, gg, dp);
+  if (as_fused_function)
+  {
+    bcg.set_as_fused_function();
+  }
   bcg.setup();
   return bcg.get_kernelstring();
 }
@@ -18,6 +18,7 @@
 #include <miopengemm/copygenerator.hpp>
 #include <miopengemm/derivedparams.hpp>
 #include <miopengemm/error.hpp>
+#include <miopengemm/fusedgenerator.hpp>
 #include <miopengemm/normalformgenerator.hpp>
 #include <miopengemm/stringutilbase.hpp>
 
@@ -108,11 +109,20 @@ std::vector<std::vector<size_t>> get_v_wait_indices(const std::vector<KernBlob>&
   return v_wait_indices;
 }
 
-Bundle::Bundle(const HyPas& hp_, const Geometry& gg_) : hp(hp_), gg(gg_), dp(hp, gg)
+Bundle::Bundle(const HyPas& hp_, const Geometry& gg_, bool indent)
+  : hp(hp_), gg(gg_), dp(hp, gg)
 {
 
+  // the preparation kernels fused into one (see NonChi::E::FUS)
+  bool with_betac = (dp.main_does_beta_c_inc == 0);
+  auto fusion     = get_prep_fusion(hp);
+  bool fuse_betac = fusion.betac;
+  bool fuse_ws    = fusion.ws;
+
+  std::vector<KernBlob> fused_parts;
   for (auto emat_x : {Mat::E::A, Mat::E::B})
   {
+    auto& v_target = fuse_ws ? fused_parts : v_tgks;
 
     if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::UNUSED)
     {
@@ -121,12 +131,12 @@ Bundle::Bundle(const HyPas& hp_, const Geometry& gg_) : hp(hp_), gg(gg_), dp(hp,
 
     else if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::COPY)
     {
-      v_tgks.emplace_back(copygen::get_copy_kernelstring(emat_x, hp, gg, dp));
+      v_target.emplace_back(copygen::get_copy_kernelstring(emat_x, hp, gg, dp, fuse_ws));
     }
 
     else if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::NFORM)
     {
-      v_tgks.emplace_back(nformgen::get_nform_kernelstring(emat_x, hp, gg, dp));
+      v_target.emplace_back(nformgen::get_nform_kernelstring(emat_x, hp, gg, dp, fuse_ws));
     }
 
     else
@@ -138,20 +148,26 @@ Bundle::Bundle(const HyPas& hp_, const Geometry& gg_) : hp(hp_), gg(gg_), dp(hp,
     }
   }
 
-  if (dp.main_does_beta_c_inc == 0)
+  if (with_betac)
+  {
+    auto& v_target = fuse_betac ? fused_parts : v_tgks;
+    v_target.emplace_back(betacgen::get_betac_kernelstring(hp, gg, dp, fuse_betac));
+  }
+
+  if (fused_parts.size() != 0)
   {
-    v_tgks.emplace_back(betacgen::get_betac_kernelstring(hp, gg, dp));
+    v_tgks.emplace_back(fusedgen::get_fused_kernelstring(fused_parts, hp, gg, dp));
   }
 
   v_tgks.emplace_back(alphagen::get_alpha_kernelstring(hp, gg, dp));
 
-  // indent the kernel strings, in case someone wants to
-  // print them. For (v-minorly) better
-  // performance, this should not be done
   // Maybe clang-format could do this, but better without the dependency
-  for (auto& x : v_tgks)
+  if (indent)
   {
-    stringutil::indentify(x.kernstr);
+    for (auto& x : v_tgks)
+    {
+      stringutil::indentify(x.kernstr);
+    }
   }
 }
 }
@@ -47,9 +47,9 @@ ByLineGenerator::ByLineGenerator(Mat::E               emat_x_,
 {
 }
 
-void ByLineGenerator::append_description_string(std::stringstream& ss) { ss << description_string; }
+void ByLineGenerator::append_description_string(emit::Emitter& ss) { ss << description_string; }
 
-void ByLineGenerator::append_how_definitions(std::stringstream& ss)
+void ByLineGenerator::append_how_definitions(emit::Emitter& ss)
 {
   ss <<
     R"(/* The number of values from C which each non-edge work-item will scale by beta */
@@ -60,7 +60,7 @@ void ByLineGenerator::append_how_definitions(std::stringstream& ss)
      << get_local_work_size() << "\n\n";
 }
 
-void ByLineGenerator::append_derived_definitions(std::stringstream& ss)
+void ByLineGenerator::append_derived_definitions(emit::Emitter& ss)
 {
 
   ss << "/*      each (full) work item will process WORK_PER_THREAD elements "
@@ -100,11 +100,11 @@ size_t ByLineGenerator::get_n_work_groups()
   return number_of_workgroups;
 }
 
-void ByLineGenerator::append_setup_coordinates(std::stringstream& ss)
+void ByLineGenerator::append_setup_coordinates(emit::Emitter& ss)
 {
 
   ss << "\n\n\n/* setting up where this thread works */";
-  ss << "TINT" << MCHAR << " group_id = get_group_id(0);\n";
+  ss << "TINT" << MCHAR << " group_id = " << get_group_id_string() << ";\n";
   ss << "TSHORT local_id = (TSHORT)(get_local_id(0));\n";
   ss << "TINT" << MCHAR << " global_id = group_id*N_WORK_ITEMS_PER_GROUP + local_id;\n";
   ss << "TINT" << MCHAR << " start_uncoal = 0;\n";
@@ -134,7 +134,7 @@ start_coal = START_IN_COAL_LAST_WORK_ITEM;
   }
 }
 
-void ByLineGenerator::append_positioning_x_string(std::stringstream& ss)
+void ByLineGenerator::append_positioning_x_string(emit::Emitter& ss)
 {
 
   ss << "\n\n/* moving the " << mchar << " pointer to the first element to process */\n";
@@ -143,9 +143,9 @@ void ByLineGenerator::append_positioning_x_string(std::stringstream& ss)
   ss << mchar << " += start_coal;\n";
 }
 
-void ByLineGenerator::append_inner_work(std::stringstream& ss) { ss << inner_work_string; }
+void ByLineGenerator::append_inner_work(emit::Emitter& ss) { ss << inner_work_string; }
 
-void ByLineGenerator::append_work_string(std::stringstream& ss)
+void ByLineGenerator::append_work_string(emit::Emitter& ss)
 {
 
   ss <<
@@ -163,7 +163,7 @@ for (TSHORT i = 0; i < WORK_FOR_LAST_ITEM_IN_COAL; ++i){  )";
   ss << "\n}\n}\n";
 }
 
-void ByLineGenerator::append_positioning_w_string(std::stringstream& ss)
+void ByLineGenerator::append_positioning_w_string(emit::Emitter& ss)
 {
 
   ss << R"(
@@ -176,11 +176,9 @@ w += start_coal;
 )";
 }
 
-KernBlob ByLineGenerator::get_kernelstring()
+void ByLineGenerator::append_kernelstring(emit::Emitter& ss)
 {
 
-  std::stringstream ss;
-
   ss << get_time_string();
   append_description_string(ss);
 
@@ -196,13 +194,8 @@ KernBlob ByLineGenerator::get_kernelstring()
   ss << "#define TINT" << MCHAR << " " << dp.tints[emat_x] << "\n";
   ss << "#define TSHORT" << ' ' << dp.tshort << '\n';
 
-  ss << "\n\n"
-     << "__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))"
-     << "\n";
-  ss << "__kernel void ";
-
-  ss << kernelname;
-  append_fargs(ss);
+  ss << "\n\n";
+  append_declaration(ss);
 
   ss << "{";
 
@@ -217,13 +210,6 @@ KernBlob ByLineGenerator::get_kernelstring()
   append_work_string(ss);
 
   ss << "\n}\n\n\n";
-
-  return {get_ktype(),
-          {u_a, u_b, u_c, u_w, u_alpha, u_beta},
-          ss.str(),
-          kernelname,
-          get_global_work_size(),
-          get_local_work_size()};
 }
 }
 }
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <sstream>
+#include <string>
+#include <miopengemm/convolution.hpp>
+#include <miopengemm/error.hpp>
+
+namespace MIOpenGEMM
+{
+
+Convolution::Convolution(bool   nhwc_,
+                         size_t c_,
+                         size_t h_,
+                         size_t w_,
+                         size_t r_,
+                         size_t s_,
+                         size_t pad_h_,
+                         size_t pad_w_,
+                         size_t stride_h_,
+                         size_t stride_w_,
+                         size_t dilation_h_,
+                         size_t dilation_w_)
+  : nhwc(nhwc_),
+    c(c_),
+    h(h_),
+    w(w_),
+    r(r_),
+    s(s_),
+    pad_h(pad_h_),
+    pad_w(pad_w_),
+    stride_h(stride_h_),
+    stride_w(stride_w_),
+    dilation_h(dilation_h_),
+    dilation_w(dilation_w_)
+{
+  if (c * h * w * r * s * stride_h * stride_w * dilation_h * dilation_w == 0)
+  {
+    throw miog_error("In Convolution constructor, all dimensions, strides and dilations should "
+                     "be positive : " +
+                     get_string());
+  }
+
+  if (h + 2 * pad_h < dilation_h * (r - 1) + 1 || w + 2 * pad_w < dilation_w * (s - 1) + 1)
+  {
+    throw miog_error("In Convolution constructor, the (dilated) filter is larger than the "
+                     "padded image : " +
+                     get_string());
+  }
+}
+
+size_t Convolution::get_out_h() const
+{
+  return (h + 2 * pad_h - dilation_h * (r - 1) - 1) / stride_h + 1;
+}
+
+size_t Convolution::get_out_w() const
+{
+  return (w + 2 * pad_w - dilation_w * (s - 1) - 1) / stride_w + 1;
+}
+
+bool Convolution::get_image_index(size_t kk, size_t nn, size_t& index) const
+{
+  size_t ci = kk / (r * s);
+  size_t ri = (kk / s) % r;
+  size_t si = kk % s;
+  size_t hi = (nn / get_out_w()) * stride_h + ri * dilation_h;
+  size_t wi = (nn % get_out_w()) * stride_w + si * dilation_w;
+  // hi and wi are offset by the padding
+  if (hi < pad_h || hi >= h + pad_h || wi < pad_w || wi >= w + pad_w)
+  {
+    return false;
+  }
+  hi -= pad_h;
+  wi -= pad_w;
+  index = nhwc ? (hi * w + wi) * c + ci : (ci * h + hi) * w + wi;
+  return true;
+}
+
+std::string Convolution::get_string() const
+{
+  std::stringstream ss;
+  ss << "NHWC" << nhwc << "_C" << c << "_H" << h << "_W" << w << "_R" << r << "_S" << s << "_padH"
+     << pad_h << "_padW" << pad_w << "_strH" << stride_h << "_strW" << stride_w << "_dilH"
+     << dilation_h << "_dilW" << dilation_w;
+  return ss.str();
+}
+
+bool Convolution::operator==(const Convolution& rhs) const
+{
+  return nhwc == rhs.nhwc && c == rhs.c && h == rhs.h && w == rhs.w && r == rhs.r && s == rhs.s &&
+         pad_h == rhs.pad_h && pad_w == rhs.pad_w && stride_h == rhs.stride_h &&
+         stride_w == rhs.stride_w && dilation_h == rhs.dilation_h &&
+         dilation_w == rhs.dilation_w;
+}
+}
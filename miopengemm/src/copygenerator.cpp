@@ -40,7 +40,7 @@ void CopyGenerator::setup_additional()
   inner_work_string  = std::string("\n/* the copy */\nw[i] = ") + std::string(1, mchar) + "[i];";
 }
 
-void CopyGenerator::append_derived_definitions_additional(std::stringstream& ss)
+void CopyGenerator::append_derived_definitions_additional(emit::Emitter& ss)
 {
   if (emat_x != Mat::E::A && emat_x != Mat::E::B)
   {
@@ -54,8 +54,11 @@ void CopyGenerator::append_derived_definitions_additional(std::stringstream& ss)
   ss << "#define GLOBAL_OFFSET_W " << dp.at(emat_x).cw_global_offset << "\n";
 }
 
-KernBlob
-get_copy_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+KernBlob get_copy_kernelstring(Mat::E               emat_x,
+                               const HyPas&         hp,
+                               const Geometry&      gg,
+                               const DerivedParams& dp,
+                               bool                 as_fused_function)
 {
 
   if (emat_x != Mat::E::A and emat_x != Mat::E::B)
@@ -64,6 +67,10 @@ get_copy_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const
   }
 
   CopyGenerator cg(emat_x, hp, gg, dp);
+  if (as_fused_function)
+  {
+    cg.set_as_fused_function();
+  }
   cg.setup();
   return cg.get_kernelstring();
 }
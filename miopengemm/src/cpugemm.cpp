@@ -1,7 +1,12 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
 #include <miopengemm/cpugemm.hpp>
 #include <miopengemm/error.hpp>
 #include <miopengemm/geometry.hpp>
@@ -271,16 +276,281 @@ void gemm_3fors(const Geometry& gg,
 }
 }
 
+// cache blocked, with A and B packed into panels, and the columns of C shared between threads.
+// The micro tiles of C are MR x NR, NR being 2 vectors of the widest instruction set enabled
+// at compile time (AVX-512, AVX, else 16 bytes as SSE and NEON), for the compiler to vectorise.
+namespace blocked
+{
+
+#if defined(__AVX512F__)
+const size_t vector_bytes = 64;
+#elif defined(__AVX__)
+const size_t vector_bytes = 32;
+#else
+const size_t vector_bytes = 16;
+#endif
+
+const size_t MR = 4;
+// the dimensions of the panels of A (MC x KC) and B (KC x NC), to stay in cache
+const size_t MC = 128;
+const size_t KC = 256;
+const size_t NC = 512;
+
 template <typename TFloat>
-void gemm(Geometry        gg,
-          Offsets         toff,
-          const TFloat*   a,
-          const TFloat*   b,
-          TFloat*         c,
-          TFloat          alpha,
-          TFloat          beta,
-          owrite::Writer& mowri)
+constexpr size_t get_nr()
+{
+  return 2 * vector_bytes / sizeof(TFloat);
+}
+
+// mc x kc of A, starting at (x0, z0), into micro panels of MR rows, contiguous along MR.
+// Rows beyond mc are 0. If a_abs_pack is not nullptr, abs(A) is packed into it too.
+template <typename TFloat>
+void pack_a(const Geometry& gg,
+            const TFloat*   a,
+            size_t          x0,
+            size_t          mc,
+            size_t          z0,
+            size_t          kc,
+            TFloat*         a_pack,
+            TFloat*         a_abs_pack)
+{
+  size_t lda = gg.ldX[Mat::E::A];
+  bool   tA  = gg.tX[Mat::E::A];
+  for (size_t xr = 0; xr < mc; xr += MR)
+  {
+    for (size_t z = 0; z < kc; ++z)
+    {
+      for (size_t i = 0; i < MR; ++i)
+      {
+        size_t x = x0 + xr + i;
+        TFloat v = (xr + i < mc) ? (tA ? a[x * lda + z0 + z] : a[x + (z0 + z) * lda]) : TFloat(0);
+        *a_pack++ = v;
+        if (a_abs_pack != nullptr)
+        {
+          *a_abs_pack++ = std::abs(v);
+        }
+      }
+    }
+  }
+}
+
+// kc x nc of B, starting at (z0, y0), into micro panels of NR columns, contiguous along NR.
+// Columns beyond nc are 0. If b_abs_pack is not nullptr, abs(B) is packed into it too.
+template <typename TFloat>
+void pack_b(const Geometry& gg,
+            const TFloat*   b,
+            size_t          z0,
+            size_t          kc,
+            size_t          y0,
+            size_t          nc,
+            TFloat*         b_pack,
+            TFloat*         b_abs_pack)
+{
+  const size_t NR  = get_nr<TFloat>();
+  size_t       ldb = gg.ldX[Mat::E::B];
+  bool         tB  = gg.tX[Mat::E::B];
+  for (size_t yr = 0; yr < nc; yr += NR)
+  {
+    for (size_t z = 0; z < kc; ++z)
+    {
+      for (size_t j = 0; j < NR; ++j)
+      {
+        size_t y = y0 + yr + j;
+        TFloat v = (yr + j < nc) ? (tB ? b[(z0 + z) * ldb + y] : b[z0 + z + y * ldb]) : TFloat(0);
+        *b_pack++ = v;
+        if (b_abs_pack != nullptr)
+        {
+          *b_abs_pack++ = std::abs(v);
+        }
+      }
+    }
+  }
+}
+
+// C[x0 : x0 + mr, y0 : y0 + nr] += alpha * (micro panel of A) * (micro panel of B)
+template <typename TFloat>
+void micro_kernel(size_t        kc,
+                  const TFloat* a_pack,
+                  const TFloat* b_pack,
+                  TFloat        alpha,
+                  TFloat*       c,
+                  size_t        ldc,
+                  size_t        mr,
+                  size_t        nr)
+{
+  const size_t NR                        = get_nr<TFloat>();
+  TFloat       acc[MR][get_nr<TFloat>()] = {};
+  for (size_t z = 0; z < kc; ++z)
+  {
+    for (size_t i = 0; i < MR; ++i)
+    {
+      TFloat a_zi = a_pack[z * MR + i];
+      for (size_t j = 0; j < NR; ++j)
+      {
+        acc[i][j] += a_zi * b_pack[z * NR + j];
+      }
+    }
+  }
+
+  for (size_t j = 0; j < nr; ++j)
+  {
+    for (size_t i = 0; i < mr; ++i)
+    {
+      c[i + j * ldc] += alpha * acc[i][j];
+    }
+  }
+}
+
+// the columns [y0, y1) of C, and of C_abs if it is not nullptr. The panels of A and B are packed
+// once for both, C_abs being computed from the panels of abs(A) and abs(B).
+template <typename TFloat>
+void gemm_columns(const Geometry& gg,
+                  const TFloat*   a,
+                  const TFloat*   b,
+                  TFloat*         c,
+                  TFloat*         c_abs,
+                  TFloat          alpha,
+                  TFloat          beta,
+                  size_t          y0,
+                  size_t          y1)
+{
+  const size_t NR  = get_nr<TFloat>();
+  size_t       ldc = gg.ldX[Mat::E::C];
+
+  // as in gemm_3fors, C is overwritten when beta is 0
+  bool overwrite = !(beta > 0 || beta < 0);
+  for (size_t y = y0; y < y1; ++y)
+  {
+    for (size_t x = 0; x < gg.m; ++x)
+    {
+      TFloat beta_c = overwrite ? TFloat(0) : beta * c[x + y * ldc];
+      if (c_abs != nullptr)
+      {
+        c_abs[x + y * ldc] = std::abs(beta_c);
+      }
+      c[x + y * ldc] = beta_c;
+    }
+  }
+
+  bool                with_abs = c_abs != nullptr;
+  std::vector<TFloat> a_pack(MC * KC);
+  std::vector<TFloat> b_pack(KC * NC);
+  std::vector<TFloat> a_abs_pack(with_abs ? MC * KC : 0);
+  std::vector<TFloat> b_abs_pack(with_abs ? KC * NC : 0);
+  for (size_t yc = y0; yc < y1; yc += NC)
+  {
+    size_t nc = std::min(NC, y1 - yc);
+    for (size_t zc = 0; zc < gg.k; zc += KC)
+    {
+      size_t kc = std::min(KC, gg.k - zc);
+      pack_b(gg, b, zc, kc, yc, nc, b_pack.data(), with_abs ? b_abs_pack.data() : nullptr);
+      for (size_t xc = 0; xc < gg.m; xc += MC)
+      {
+        size_t mc = std::min(MC, gg.m - xc);
+        pack_a(gg, a, xc, mc, zc, kc, a_pack.data(), with_abs ? a_abs_pack.data() : nullptr);
+        for (size_t yr = 0; yr < nc; yr += NR)
+        {
+          for (size_t xr = 0; xr < mc; xr += MR)
+          {
+            size_t c_index = (xc + xr) + (yc + yr) * ldc;
+            micro_kernel(kc,
+                         a_pack.data() + xr * kc,
+                         b_pack.data() + yr * kc,
+                         alpha,
+                         c + c_index,
+                         ldc,
+                         std::min(MR, mc - xr),
+                         std::min(NR, nc - yr));
+            if (with_abs)
+            {
+              micro_kernel(kc,
+                           a_abs_pack.data() + xr * kc,
+                           b_abs_pack.data() + yr * kc,
+                           std::abs(alpha),
+                           c_abs + c_index,
+                           ldc,
+                           std::min(MR, mc - xr),
+                           std::min(NR, nc - yr));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename TFloat>
+void gemm_blocked(const Geometry& gg,
+                  const Offsets&  toff,
+                  const TFloat*   a,
+                  const TFloat*   b,
+                  TFloat*         c,
+                  TFloat*         c_abs,
+                  TFloat          alpha,
+                  TFloat          beta)
 {
+  a += toff.offsets[Mem::E::A];
+  b += toff.offsets[Mem::E::B];
+  c += toff.offsets[Mem::E::C];
+  c_abs = c_abs == nullptr ? nullptr : c_abs + toff.offsets[Mem::E::C];
+
+  // the threads process contiguous micro panels of columns of C
+  const size_t NR           = get_nr<TFloat>();
+  size_t       n_col_panels = (gg.n + NR - 1) / NR;
+  size_t       n_threads    = std::max<size_t>(1, std::thread::hardware_concurrency());
+  n_threads                 = std::max<size_t>(1, std::min(n_threads, n_col_panels));
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < n_threads; ++t)
+  {
+    size_t y0 = std::min(gg.n, NR * ((t * n_col_panels) / n_threads));
+    size_t y1 = std::min(gg.n, NR * (((t + 1) * n_col_panels) / n_threads));
+    threads.emplace_back([&gg, a, b, c, c_abs, alpha, beta, y0, y1]() {
+      gemm_columns<TFloat>(gg, a, b, c, c_abs, alpha, beta, y0, y1);
+    });
+  }
+
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+}
+}
+
+// c_abs is only used by the blocked algorithm, and may be nullptr
+template <typename TFloat>
+void gemm_base(Geometry        gg,
+               Offsets         toff,
+               const TFloat*   a,
+               const TFloat*   b,
+               TFloat*         c,
+               TFloat*         c_abs,
+               TFloat          alpha,
+               TFloat          beta,
+               owrite::Writer& mowri,
+               bool            naive)
+{
+
+  // implicit B (a convolution) : the im2col matrix is materialised here
+  std::vector<TFloat> b_im2col;
+  if (gg.conv.is_set())
+  {
+    size_t b_offset = toff.offsets[Mem::E::B];
+    b_im2col.resize(b_offset + gg.n * gg.ldX[Mat::E::B], 0);
+    for (size_t nn = 0; nn < gg.n; ++nn)
+    {
+      for (size_t kk = 0; kk < gg.k; ++kk)
+      {
+        size_t index;
+        if (gg.conv.get_image_index(kk, nn, index))
+        {
+          b_im2col[b_offset + kk + nn * gg.ldX[Mat::E::B]] = b[b_offset + index];
+        }
+      }
+    }
+    b       = b_im2col.data();
+    gg.conv = {};
+  }
 
   bool tA = gg.tX[Mat::E::A];
   bool tB = gg.tX[Mat::E::B];
@@ -306,20 +576,94 @@ void gemm(Geometry        gg,
   gg.check_ldx_consistent();
   auto t0 = std::chrono::high_resolution_clock::now();
 
-// dispatch depending on x
+  // dispatch depending on x
+  if (naive)
+  {
+    mowri << "launching slow 3-fors CPU GEMM algorithm. " << Endl;
+    custom::gemm_3fors<TFloat>(gg, toff, a, b, c, alpha, beta);
+  }
+  else
+  {
 #ifdef MIOPENGEMM_USE_OPENBLAS
-  mowri << "launching OpenBLAS CPU GEMM algorithm. " << Endl;
-  openblas::gemm_openblas<TFloat>(gg, toff, a, b, c, alpha, beta);
+    mowri << "launching OpenBLAS CPU GEMM algorithm. " << Endl;
+    openblas::gemm_openblas<TFloat>(gg, toff, a, b, c, alpha, beta);
 #else
-  mowri << "launching slow 3-fors CPU GEMM algorithm. " << Endl;
-  custom::gemm_3fors<TFloat>(gg, toff, a, b, c, alpha, beta);
+    mowri << "launching blocked multithreaded CPU GEMM algorithm. " << Endl;
+    blocked::gemm_blocked<TFloat>(gg, toff, a, b, c, c_abs, alpha, beta);
 #endif  // end of no openblas case
+  }
 
   auto t1           = std::chrono::high_resolution_clock::now();
   auto elapsed_time = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
   mowri << "elapsed time : " << elapsed_time * 1e-6 << " [s] " << Endl;
 }
 
+template <typename TFloat>
+void gemm(Geometry        gg,
+          Offsets         toff,
+          const TFloat*   a,
+          const TFloat*   b,
+          TFloat*         c,
+          TFloat          alpha,
+          TFloat          beta,
+          owrite::Writer& mowri)
+{
+  gemm_base<TFloat>(gg, toff, a, b, c, nullptr, alpha, beta, mowri, false);
+}
+
+template <typename TFloat>
+void gemm_3fors(Geometry        gg,
+                Offsets         toff,
+                const TFloat*   a,
+                const TFloat*   b,
+                TFloat*         c,
+                TFloat          alpha,
+                TFloat          beta,
+                owrite::Writer& mowri)
+{
+  gemm_base<TFloat>(gg, toff, a, b, c, nullptr, alpha, beta, mowri, true);
+}
+
+template <typename TFloat>
+void gemm_with_abs(Geometry        gg,
+                   Offsets         toff,
+                   const TFloat*   a,
+                   const TFloat*   b,
+                   TFloat*         c,
+                   TFloat*         c_abs,
+                   TFloat          alpha,
+                   TFloat          beta,
+                   owrite::Writer& mowri)
+{
+#ifdef MIOPENGEMM_USE_OPENBLAS
+  // OpenBLAS has no fused absolute GEMM : it is run again, on copies of abs(A), abs(B), abs(C)
+  std::array<std::vector<TFloat>, Mat::E::N> abs_mem;
+  std::array<const TFloat*, Mat::E::N>       mem{{a, b, c}};
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    abs_mem[emat].resize(get_mat_size(gg, toff, emat));
+    std::transform(mem[emat],
+                   mem[emat] + abs_mem[emat].size(),
+                   abs_mem[emat].begin(),
+                   [](TFloat x) { return std::abs(x); });
+  }
+  gemm_base<TFloat>(gg, toff, a, b, c, nullptr, alpha, beta, mowri, false);
+  gemm_base<TFloat>(gg,
+                    toff,
+                    abs_mem[Mat::E::A].data(),
+                    abs_mem[Mat::E::B].data(),
+                    abs_mem[Mat::E::C].data(),
+                    nullptr,
+                    std::abs(alpha),
+                    std::abs(beta),
+                    mowri,
+                    false);
+  std::copy(abs_mem[Mat::E::C].begin(), abs_mem[Mat::E::C].end(), c_abs);
+#else
+  gemm_base<TFloat>(gg, toff, a, b, c, c_abs, alpha, beta, mowri, false);
+#endif
+}
+
 template void gemm(Geometry        gg,
                    Offsets         toff,
                    const float*    a,
@@ -337,5 +681,42 @@ template void gemm(Geometry        gg,
                    double          alpha,
                    double          beta,
                    owrite::Writer& mowri);
+template void gemm_3fors(Geometry        gg,
+                         Offsets         toff,
+                         const float*    a,
+                         const float*    b,
+                         float*          c,
+                         float           alpha,
+                         float           beta,
+                         owrite::Writer& mowri);
+
+template void gemm_3fors(Geometry        gg,
+                         Offsets         toff,
+                         const double*   a,
+                         const double*   b,
+                         double*         c,
+                         double          alpha,
+                         double          beta,
+                         owrite::Writer& mowri);
+
+template void gemm_with_abs(Geometry        gg,
+                            Offsets         toff,
+                            const float*    a,
+                            const float*    b,
+                            float*          c,
+                            float*          c_abs,
+                            float           alpha,
+                            float           beta,
+                            owrite::Writer& mowri);
+
+template void gemm_with_abs(Geometry        gg,
+                            Offsets         toff,
+                            const double*   a,
+                            const double*   b,
+                            double*         c,
+                            double*         c_abs,
+                            double          alpha,
+                            double          beta,
+                            owrite::Writer& mowri);
 }
 }
@@ -118,6 +118,23 @@ bool is_dvble(const HyPas& hp, const Geometry& gg)
   return dble.is_derivable;
 }
 
+PrepFusion get_prep_fusion(const HyPas& hp)
+{
+  const SuHy& suc = hp.sus[Mat::E::C];
+  size_t      fus = suc.vs[NonChi::E::FUS];
+  // C is scaled by beta in its own kernel (main_does_beta_c_inc is 0) with split k or stream-K
+  bool   with_betac = suc.vs[NonChi::E::ICE] != 1 || suc.vs[NonChi::E::STK] != 0;
+  size_t n_ws       = 0;
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    n_ws += (hp.sus[emat_x].vs[Chi::E::WOS] != Scratch::E::UNUSED);
+  }
+  PrepFusion fusion;
+  fusion.betac = (fus == 2 && with_betac && n_ws >= 1);
+  fusion.ws    = (fus >= 1 && n_ws + (fusion.betac ? 1 : 0) >= 2);
+  return fusion;
+}
+
 DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_, std::string s)
   : ptr_hp(&hp_), ptr_gg(&gg_)
 {
@@ -149,9 +166,12 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
       1 + (ptr_gg->get_non_k_dim(emat_x) - 1) % at(emat_x).macro_tile_length;
     at(emat_x).n_groups = ptr_gg->get_non_k_dim(emat_x) / at(emat_x).macro_tile_length +
                           (at(emat_x).preshift_final_tile != at(emat_x).macro_tile_length);
+    // with SWZ, the padding is replaced by swizzling
     at(emat_x).main_macro_tile_length_and_pad =
       at(emat_x).macro_tile_length +
-      ptr_hp->sus[emat_x].vs[Chi::E::VEW] * ptr_hp->sus[emat_x].vs[Chi::E::PAD];
+      (ptr_hp->sus[emat_x].vs[Chi::E::SWZ] == Binary::E::YES
+         ? 0
+         : ptr_hp->sus[emat_x].vs[Chi::E::VEW] * ptr_hp->sus[emat_x].vs[Chi::E::PAD]);
 
     at(emat_x).main_n_elements_in_padded_unroll =
       at(emat_x).main_macro_tile_length_and_pad * ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR];
@@ -226,6 +246,15 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
                   << " ) is less then the required workspace ( " << required_workspace << " ). ";
   }
 
+  // implicit B (a convolution) is computed element by element from the image, in the main kernel
+  if (ptr_gg->conv.is_set() &&
+      (ptr_hp->sus[Mat::E::B].vs[Chi::E::VEW] != 1 ||
+       ptr_hp->sus[Mat::E::B].vs[Chi::E::WOS] != Scratch::E::UNUSED))
+  {
+    set_status_ss << "B is implicit (a convolution), so VEW of B should be 1 and WOS of B "
+                  << "should be UNUSED. ";
+  }
+
   if (set_status_ss.str() != "")
   {
     return std::make_tuple(false, set_status_ss.str());
@@ -302,7 +331,52 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
   }
 
   main_split_on_k      = ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] == 1 ? 0 : 1;
-  main_does_beta_c_inc = main_split_on_k == 1 ? 0 : 1;
+  main_stream_k        = ptr_hp->sus[Mat::E::C].vs[NonChi::E::STK] == 0 ? 0 : 1;
+  main_does_beta_c_inc = (main_split_on_k == 1 || main_stream_k == 1) ? 0 : 1;
+  main_n_lds_buffers   = ptr_hp->sus[Mat::E::C].vs[NonChi::E::DBL] == Binary::E::YES ? 2 : 1;
+  main_n_prefetch_registers =
+    ptr_hp->sus[Mat::E::C].vs[NonChi::E::PFR] == Binary::E::YES
+      ? at(Mat::E::A).main_n_elements_to_load_per_workitem +
+          at(Mat::E::B).main_n_elements_to_load_per_workitem
+      : 0;
+
+  // the prefetched unroll should not take more registers than the C micro tile
+  if (main_n_prefetch_registers > main_micro_tile_area)
+  {
+    std::stringstream ss;
+    ss << "PFR = yes, but the prefetch registers (" << main_n_prefetch_registers
+       << ") would be more than those of the micro tile (" << main_micro_tile_area << "). ";
+    return std::make_tuple(false, ss.str());
+  }
+
+  main_n_stream_k_units = 0;
+  if (main_stream_k == 1)
+  {
+    std::stringstream ss;
+    if (main_split_on_k == 1 || ptr_hp->sus[Mat::E::C].vs[NonChi::E::UFO] == Binary::E::YES)
+    {
+      ss << "STK > 0 (stream-K) is only supported with ICE = 1 and UFO = no. ";
+      return std::make_tuple(false, ss.str());
+    }
+
+    // the work units are whole unrolls, there is no tail
+    if (ptr_gg->k % ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR] != 0)
+    {
+      ss << "STK > 0 (stream-K), but k (" << ptr_gg->k << ") is not a multiple of UNR ("
+         << ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR] << "). ";
+      return std::make_tuple(false, ss.str());
+    }
+
+    main_n_stream_k_units = at(Mat::E::A).n_groups * at(Mat::E::B).n_groups *
+                            (ptr_gg->k / ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR]);
+    if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::STK] > main_n_stream_k_units)
+    {
+      ss << "STK (" << ptr_hp->sus[Mat::E::C].vs[NonChi::E::STK]
+         << ") is larger than the number of (tile, unroll) work units (" << main_n_stream_k_units
+         << "). ";
+      return std::make_tuple(false, ss.str());
+    }
+  }
 
   if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::GAL] == 3)
   {
@@ -330,6 +404,26 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
     ga3_last_super_column_width = bdps.n_groups % ga3_super_column_width;
   }
 
+  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::MORTON ||
+      ptr_hp->sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::HILBERT)
+  {
+    // the widest block with at most ~ NAW / ICE work groups, which fits in the grid
+    size_t n_target = ptr_hp->sus[Mat::E::C].vs[NonChi::E::NAW] /
+                      ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE];
+    size_t max_width = std::min(at(Mat::E::A).n_groups, at(Mat::E::B).n_groups);
+    sfc_block_width  = 1;
+    while (4 * sfc_block_width * sfc_block_width <= n_target && 2 * sfc_block_width <= max_width)
+    {
+      sfc_block_width *= 2;
+    }
+
+    if (sfc_block_width == 1)
+    {
+      return std::make_tuple(false,
+                             "sfc_block_width would be 1 (ICE * 4 > NAW, or too few work groups)");
+    }
+  }
+
   // do the tiling
   for (auto emat_x : {Mat::E::A, Mat::E::B})
   {
@@ -423,6 +517,25 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
     return std::make_tuple(false, viza);
   }
 
+  // the swizzle stays within aligned blocks of columns whose size is a power of 2 dividing the
+  // row length (in vectors), so that it permutes the columns of each row. 32 covers the banks.
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    at(emat_x).main_lds_swizzle_mask = 0;
+    if (ptr_hp->sus[emat_x].vs[Chi::E::SWZ] == Binary::E::YES)
+    {
+      size_t row_v = at(emat_x).macro_tile_length / ptr_hp->sus[emat_x].vs[Chi::E::VEW];
+      at(emat_x).main_lds_swizzle_mask = std::min<size_t>(row_v & (~row_v + 1), 32) - 1;
+      if (at(emat_x).main_lds_swizzle_mask == 0)
+      {
+        std::stringstream ss;
+        ss << "SWZ = yes, but the LDS row length of " << Mat::M().name[emat_x] << " in vectors ("
+           << row_v << ") is odd, there is nothing to swizzle. ";
+        return std::make_tuple(false, ss.str());
+      }
+    }
+  }
+
   bool run_ROCm_test = false;
   if (run_ROCm_test == true)
   {
@@ -482,10 +595,11 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_) : ptr_hp(&hp
                      std::get<1>(tup));
   }
 
-  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] == 1)
+  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] == 1 &&
+      ptr_hp->sus[Mat::E::C].vs[NonChi::E::STK] == 0)
   {
-    infa = "n_work_items_per_c_elm is 1, should not be using atomics";
-    fati = "n_work_items_per_c_elm is 1, should not be using atomics";
+    infa = "n_work_items_per_c_elm is 1 and no stream-K, should not be using atomics";
+    fati = "n_work_items_per_c_elm is 1 and no stream-K, should not be using atomics";
   }
 
   else
@@ -509,6 +623,10 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_) : ptr_hp(&hp
                         (ptr_gg->m % at(Mat::E::A).macro_tile_length != 0)) *
                        ((ptr_gg->n / at(Mat::E::B).macro_tile_length) +
                         (ptr_gg->n % at(Mat::E::B).macro_tile_length != 0));
+  if (main_stream_k == 1)
+  {
+    main_n_work_groups = ptr_hp->sus[Mat::E::C].vs[NonChi::E::STK];
+  }
 
   main_global_work_size = main_n_work_groups * main_n_work_items_per_workgroup;
 
@@ -516,6 +634,15 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_) : ptr_hp(&hp
                          ptr_gg->n % at(Mat::E::B).macro_tile_length == 0)
                           ? 0
                           : 1;
+  main_c_vector_emat =
+    ptr_gg->tX[Mat::E::C] == ptr_gg->isColMajor ? Mat::E::B : Mat::E::A;
+  size_t c_vew = ptr_hp->sus[main_c_vector_emat].vs[Chi::E::VEW];
+  main_c_vector_width =
+    (main_split_on_k == 0 && main_stream_k == 0 && ptr_gg->ldX[Mat::E::C] % c_vew == 0 &&
+     at(main_c_vector_emat).preshift_final_tile == at(main_c_vector_emat).macro_tile_length)
+      ? c_vew
+      : 1;
+
   main_final_fractional_unroll = (ptr_hp->sus[Mat::E::C].vs[NonChi::E::UFO] == 1 ||
                                   ptr_gg->k % ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR] != 0)
                                    ? 1
@@ -523,7 +650,9 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_) : ptr_hp(&hp
 
   tints[Mem::E::A] = get_tint(ptr_gg->get_uncoal(Mat::E::A) *
                               (ptr_gg->ldX[Mat::E::A]));  // TODO : does UFO need increase here ?
-  tints[Mem::E::B] = get_tint(ptr_gg->get_uncoal(Mat::E::B) * (ptr_gg->ldX[Mat::E::B]));
+  // with a convolution, indices into both B and the image
+  tints[Mem::E::B] = get_tint(std::max(ptr_gg->get_uncoal(Mat::E::B) * ptr_gg->ldX[Mat::E::B],
+                                       ptr_gg->get_padded_area(Mat::E::B)));
   tints[Mem::E::C] = get_tint(ptr_gg->get_uncoal(Mat::E::C) * (ptr_gg->ldX[Mat::E::C]));
   tints[Mem::E::W] = get_tint(ptr_gg->wSpaceSize);
   tintk            = get_tint(
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <miopengemm/emitter.hpp>
+
+namespace MIOpenGEMM
+{
+namespace emit
+{
+
+namespace
+{
+// the generated kernel strings are mostly between 4 and 32 KB
+const size_t initial_capacity = 32 * 1024;
+}
+
+Emitter::Emitter() { text.reserve(initial_capacity); }
+
+void Emitter::put_integer(bool negative, unsigned long long magnitude)
+{
+  // digits written backwards from the end of buffer
+  char  buffer[24];
+  char* end   = buffer + 24;
+  char* first = end;
+  do
+  {
+    *--first = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative)
+  {
+    *--first = '-';
+  }
+  text.append(first, end - first);
+}
+
+std::string Emitter::release()
+{
+  std::string released;
+  released.swap(text);
+  return released;
+}
+}
+}
@@ -139,6 +139,7 @@ std::vector<std::string> get_name()
   X[E::WSB]   = "WSB";
   X[E::BETAC] = "BETAC";
   X[E::MAIN]  = "MAIN";
+  X[E::PREP]  = "PREP";
   return X;
 }
 
@@ -201,6 +202,24 @@ const EnumMapper<std::string>& M()
 }
 }
 
+namespace Verification
+{
+std::vector<std::string> get_name()
+{
+  std::vector<std::string> X(E::N, unfilled<std::string>());
+  X[E::FULL]      = "FULL";
+  X[E::SAMPLED]   = "SAMPLED";
+  X[E::FREIVALDS] = "FREIVALDS";
+  return X;
+}
+const EnumMapper<std::string>& M()
+{
+  static const EnumMapper<std::string> em =
+    get_enum_mapper<std::string>(get_name(), "Verification");
+  return em;
+}
+}
+
 std::vector<int> get_priority_confirmed(std::vector<int> X, size_t target_size)
 {
   if (X.size() != target_size)
@@ -230,6 +249,7 @@ std::vector<std::string> get_name()
   X[E::MIW] = "MIW";
   X[E::WOS] = "WOS";
   X[E::VEW] = "VEW";
+  X[E::SWZ] = "SWZ";
   return X;
 }
 
@@ -243,6 +263,7 @@ std::vector<int> get_priority_basic()
   X[E::MIW] = 0;
   X[E::WOS] = 0;
   X[E::VEW] = 0;
+  X[E::SWZ] = 0;
   return X;
 }
 
@@ -325,6 +346,10 @@ std::vector<std::string> get_name()
   X[E::MAD] = "MAD";
   X[E::AFI] = "AFI";
   X[E::MIA] = "MIA";
+  X[E::DBL] = "DBL";
+  X[E::PFR] = "PFR";
+  X[E::STK] = "STK";
+  X[E::FUS] = "FUS";
   return X;
 }
 
@@ -344,6 +369,10 @@ std::vector<int> get_priority_basic()
   X[E::AFI] = -1;
   X[E::MIA] = -1;
   X[E::SZT] = -1;
+  X[E::DBL] = 0;
+  X[E::PFR] = 0;
+  X[E::STK] = 0;
+  X[E::FUS] = 0;
   return X;
 }
 
@@ -470,7 +499,8 @@ std::array<std::vector<size_t>, E::N> get_dependencies_basic()
   kdps[E::WSA]   = {};
   kdps[E::WSB]   = {};
   kdps[E::BETAC] = {};
-  kdps[E::MAIN]  = {E::BETAC, E::WSA, E::WSB};
+  kdps[E::PREP]  = {};
+  kdps[E::MAIN]  = {E::BETAC, E::WSA, E::WSB, E::PREP};
 
   for (auto& x : kdps)
   {
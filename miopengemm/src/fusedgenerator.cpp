@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <miopengemm/basegenerator.hpp>
+#include <miopengemm/error.hpp>
+#include <miopengemm/fusedgenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace fusedgen
+{
+
+namespace
+{
+// the names of the macros defined in kernstr
+std::vector<std::string> get_defined_macros(const std::string& kernstr)
+{
+  std::vector<std::string> macros;
+  std::istringstream       lines(kernstr);
+  std::string              line;
+  while (std::getline(lines, line))
+  {
+    std::istringstream words(line);
+    std::string        directive;
+    std::string        name;
+    words >> directive >> name;
+    if (directive == "#define" && name != "" &&
+        std::find(macros.begin(), macros.end(), name) == macros.end())
+    {
+      macros.push_back(name);
+    }
+  }
+  return macros;
+}
+}
+
+class FusedGenerator : public basegen::BaseGenerator
+{
+
+  private:
+  const std::vector<KernBlob>& parts;
+
+  public:
+  FusedGenerator(const std::vector<KernBlob>& parts_,
+                 const HyPas&                 hp_,
+                 const Geometry&              gg_,
+                 const DerivedParams&         dp_)
+    : basegen::BaseGenerator(hp_, gg_, dp_), parts(parts_)
+  {
+  }
+
+  private:
+  virtual void set_usage() override final
+  {
+    for (auto& part : parts)
+    {
+      u_a    = u_a || part.kuses.u_a;
+      u_b    = u_b || part.kuses.u_b;
+      u_c    = u_c || part.kuses.u_c;
+      u_w    = u_w || part.kuses.u_w;
+      u_beta = u_beta || part.kuses.u_beta;
+    }
+    u_alpha = false;
+  }
+
+  virtual void set_type() override final { type = "prep"; }
+
+  virtual void setup_final() override final {}
+
+  virtual size_t get_local_work_size() override final
+  {
+    size_t local_work_size = 0;
+    for (auto& part : parts)
+    {
+      local_work_size = std::max(local_work_size, part.local_work_size);
+    }
+    return local_work_size;
+  }
+
+  virtual size_t get_n_work_groups() override final
+  {
+    size_t n_work_groups = 0;
+    for (auto& part : parts)
+    {
+      n_work_groups += part.global_work_size / part.local_work_size;
+    }
+    return n_work_groups;
+  }
+
+  virtual KType::E get_ktype() override final { return KType::E::PREP; }
+
+  // the arguments of part, in the order of append_fargs
+  std::string get_call_args(const KernBlob& part)
+  {
+    std::string args;
+    for (auto x : {Mem::E::A, Mem::E::B, Mem::E::C, Mem::E::W})
+    {
+      if (part.kuses.at(x))
+      {
+        char mchar = Mem::M().lcase_name[x];
+        args += std::string(", ") + mchar + ", " + mchar + "_offset";
+      }
+    }
+    if (part.kuses.u_beta)
+    {
+      args += ", beta";
+    }
+    return args;
+  }
+
+  public:
+  virtual void append_kernelstring(emit::Emitter& ss) override final
+  {
+    ss << get_time_string();
+    ss << R"(
+/* ****************************************************
+* The preparation kernels (workspace copies and beta*C)
+* fused into one launch : each work group runs one of
+* the functions below, selected by its id.
+****************************************************** */
+)";
+
+    for (auto& part : parts)
+    {
+      ss << part.kernstr << '\n';
+      ss << "/* the macros of " << part.fname << " are not used beyond it */\n";
+      for (auto& macro : get_defined_macros(part.kernstr))
+      {
+        ss << "#undef " << macro << '\n';
+      }
+    }
+
+    ss << "\n#define TFLOAT " << dp.t_float << '\n';
+    ss << "#define N_WORK_ITEMS_PER_GROUP " << get_local_work_size() << '\n';
+    ss << "\n\n__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))\n";
+    ss << "__kernel void " << kernelname;
+    append_fargs(ss);
+
+    ss << "{\nconst uint group_id = get_group_id(0);\nconst uint local_id = get_local_id(0);\n";
+    size_t first_group = 0;
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+      auto&  part          = parts[i];
+      size_t n_work_groups = part.global_work_size / part.local_work_size;
+      if (i != 0)
+      {
+        ss << "else ";
+      }
+      ss << "if (group_id < " << first_group + n_work_groups << "){\n";
+      if (part.local_work_size != get_local_work_size())
+      {
+        ss << "if (local_id < " << part.local_work_size << "){\n";
+      }
+      ss << part.fname << "(group_id - " << first_group << get_call_args(part) << ");\n";
+      if (part.local_work_size != get_local_work_size())
+      {
+        ss << "}\n";
+      }
+      ss << "}\n";
+      first_group += n_work_groups;
+    }
+    ss << "}\n";
+  }
+};
+
+KernBlob get_fused_kernelstring(const std::vector<KernBlob>& parts,
+                                const HyPas&                 hp,
+                                const Geometry&              gg,
+                                const DerivedParams&         dp)
+{
+  if (parts.size() < 2)
+  {
+    std::stringstream errm;
+    errm << "get_fused_kernelstring expects at least 2 kernels to fuse, not " << parts.size();
+    throw miog_error(errm.str());
+  }
+  FusedGenerator fg(parts, hp, gg, dp);
+  fg.setup();
+  return fg.get_kernelstring();
+}
+}
+}
@@ -7,6 +7,7 @@
 #include <miopengemm/geometry.hpp>
 #include <miopengemm/hyperparams.hpp>
 #include <miopengemm/miogemm.hpp>
+#include <miopengemm/profiler.hpp>
 #include <miopengemm/programcacher.hpp>
 #include <miopengemm/programs.hpp>
 #include <miopengemm/timer.hpp>
@@ -88,6 +89,15 @@ GemmStatus xgemm(bool              isColMajor,
       kerngen::get_arg_sizes_values(program.kblob, gpu_mems, offsets, sizeof(T), &alpha, &beta));
   }
 
+  // one in profiler::get_sampling() calls is profiled (see profiler.hpp)
+  int profile_ID = -1;
+  if (profiler::sample())
+  {
+    profile_ID = ID;
+    Geometry gg(isColMajor, tA, tB, false, lda, ldb, ldc, m, n, k, w_size, get_floattype_char<T>());
+    profiler::add_call(ID, gg.get_string());
+  }
+
   KernelTimes* ktimes     = nullptr;
   bool         debug_mode = false;
   programs.run(*ptr_queue,
@@ -96,7 +106,8 @@ GemmStatus xgemm(bool              isColMajor,
                event_wait_list,
                ktimes,  // update_times,
                ptr_event_user,
-               debug_mode);
+               debug_mode,
+               profile_ID);
 
   return {true, ID};
 }
@@ -209,6 +209,30 @@ void Geometry::check_ldx_consistent() const
   }
 }
 
+void Geometry::check_conv_consistent() const
+{
+  if (!conv.is_set())
+  {
+    return;
+  }
+
+  std::stringstream errm;
+  if (isColMajor == false || tX[Mat::E::B] == true || tX[Mat::E::C] == true)
+  {
+    errm << "With a convolution, the geometry should be column major, with tB and tC false. ";
+  }
+  if (k != conv.get_k() || n != conv.get_n() || ldX[Mat::E::B] != k)
+  {
+    errm << "With a convolution, k should be c*r*s (" << conv.get_k() << "), n should be "
+         << "out_h*out_w (" << conv.get_n() << ") and ldb should be k. ";
+  }
+  if (errm.str() != "")
+  {
+    errm << "The geometry is " << get_string() << '.';
+    throw miog_error(errm.str());
+  }
+}
+
 size_t Geometry::get_uncoal(Mat::E M) const { return get_padless_dim(M, false); }
 
 // this is lda, ldb, ldc if they are minimal.
@@ -320,6 +344,15 @@ Geometry::Geometry(std::string geometry_string)
   std::string goldstandard_geometry_string = goldstandard_geometry.get_string();
   auto        goldstandard_map             = get_key_val_map(goldstandard_geometry_string);
 
+  // the keys of a convolution are optional, but come together
+  bool has_conv = key_val_map.count("NHWC") != 0;
+  if (has_conv)
+  {
+    auto goldstandard_conv_map =
+      get_key_val_map(Convolution(false, 1, 1, 1, 1, 1, 0, 0, 1, 1, 1, 1).get_string());
+    goldstandard_map.insert(goldstandard_conv_map.begin(), goldstandard_conv_map.end());
+  }
+
   std::stringstream errm_ss;
   bool              good_string{true};
   for (auto& x : key_val_map)
@@ -357,6 +390,23 @@ Geometry::Geometry(std::string geometry_string)
              safeat(key_val_map, "k"),
              safeat(key_val_map, "ws"),
              get_floattype(safeat(key_val_map, "f")));
+
+  if (has_conv)
+  {
+    conv = {safeat(key_val_map, "NHWC") != 0,
+            safeat(key_val_map, "C"),
+            safeat(key_val_map, "H"),
+            safeat(key_val_map, "W"),
+            safeat(key_val_map, "R"),
+            safeat(key_val_map, "S"),
+            safeat(key_val_map, "padH"),
+            safeat(key_val_map, "padW"),
+            safeat(key_val_map, "strH"),
+            safeat(key_val_map, "strW"),
+            safeat(key_val_map, "dilH"),
+            safeat(key_val_map, "dilW")};
+    check_conv_consistent();
+  }
 }
 
 std::string Geometry::get_string() const { return get_networkconfig_string(); }
@@ -368,6 +418,10 @@ std::string Geometry::get_networkconfig_string() const
                         << "_colMaj" << isColMajor << "_m" << m << "_n" << n << "_k" << k << "_lda"
                         << ldX[Mat::E::A] << "_ldb" << ldX[Mat::E::B] << "_ldc" << ldX[Mat::E::C]
                         << "_ws" << wSpaceSize << "_f" << derived.float_size_bits;
+  if (conv.is_set())
+  {
+    geometry_stringstream << '_' << conv.get_string();
+  }
   return geometry_stringstream.str();
 }
 
@@ -384,17 +438,26 @@ std::string Geometry::get_tabbed_string() const
                         << " ldb=" << stringutil::get_char_padded(ldX[Mat::E::B], 6)
                         << " ldc=" << stringutil::get_char_padded(ldX[Mat::E::C], 6)
                         << " ws=" << wSpaceSize << " f=" << derived.float_size_bits;
+  if (conv.is_set())
+  {
+    geometry_stringstream << " conv=" << conv.get_string();
+  }
 
   return geometry_stringstream.str();
 }
 
-size_t Geometry::get_padded_area(Mat::E M) const { return get_uncoal(M) * ldX[M]; }
+// with a convolution, the memory of B is the image
+size_t Geometry::get_padded_area(Mat::E M) const
+{
+  return (M == Mat::E::B && conv.is_set()) ? conv.get_image_size() : get_uncoal(M) * ldX[M];
+}
 
 // Safer would be compare via get_string(), assuming get_string() is comprehensive.
 bool Geometry::operator==(const Geometry& rhs) const
 {
   return (isColMajor == rhs.isColMajor && tX == rhs.tX && ldX == rhs.ldX && m == rhs.m &&
-          n == rhs.n && k == rhs.k && wSpaceSize == rhs.wSpaceSize && floattype == rhs.floattype);
+          n == rhs.n && k == rhs.k && wSpaceSize == rhs.wSpaceSize && floattype == rhs.floattype &&
+          conv == rhs.conv);
 }
 
 double Geometry::get_gflops(double extime) const { return (2. * m * n * k) / (1e9 * extime); }
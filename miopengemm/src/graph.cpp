@@ -22,6 +22,8 @@ RandomUtil& radutil17()
   return x;
 }
 
+void set_random_seed(int seed) { radutil17().seed(seed); }
+
 std::vector<HyPas> Graph::get_neighbors(const HyPas& hp0, bool prioritize) const
 {
 
@@ -168,8 +170,10 @@ std::vector<std::tuple<HyPas, int>> Graph::get_mic_mac_transformed(const HyPas&
 
 bool has_no_effect(const HyPas& hp0, Mat::E emat_x, size_t i)
 {
-  // if GAL is not SUCOL, then NAW has no effect.
-  if (hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] != GroupAllocation::E::SUCOL)
+  // if GAL is not SUCOL, MORTON or HILBERT, then NAW has no effect.
+  if (hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] != GroupAllocation::E::SUCOL &&
+      hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] != GroupAllocation::E::MORTON &&
+      hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] != GroupAllocation::E::HILBERT)
   {
     if (emat_x == Mat::E::C && i == NonChi::E::NAW)
     {
@@ -177,6 +181,13 @@ bool has_no_effect(const HyPas& hp0, Mat::E emat_x, size_t i)
     }
   }
 
+  // if SWZ is YES, there is no padding
+  if (emat_x != Mat::E::C && i == Chi::E::PAD &&
+      hp0.sus.at(emat_x).vs[Chi::E::SWZ] == Binary::E::YES)
+  {
+    return true;
+  }
+
   // if ICE is 1, the IWI has no effect
   if (hp0.sus.at(Mat::E::C).vs[NonChi::E::ICE] == 1)
   {
@@ -185,6 +196,17 @@ bool has_no_effect(const HyPas& hp0, Mat::E emat_x, size_t i)
       return true;
     }
   }
+
+  // if even the most fusing FUS fuses nothing, FUS has no effect
+  if (emat_x == Mat::E::C && i == NonChi::E::FUS)
+  {
+    HyPas hp1(hp0);
+    hp1.sus[Mat::E::C].vs[NonChi::E::FUS] = 2;
+    if (!get_prep_fusion(hp1).ws)
+    {
+      return true;
+    }
+  }
   return false;
 }
 
@@ -510,10 +532,18 @@ void ChiSuGr::initialise_edges()
   edges[Chi::E::MIW] = {g_binary()};
 
   edges[Chi::E::VEW] = {{1, {2}}, {2, {1, 4}}, {4, {2, 1}}};
+  edges[Chi::E::SWZ] = {g_binary()};
 
   edges[Chi::E::WOS] = {{Scratch::E::UNUSED, {Scratch::E::COPY, Scratch::E::NFORM}},
                         {Scratch::E::COPY, {Scratch::E::UNUSED, Scratch::E::NFORM}},
                         {Scratch::E::NFORM, {Scratch::E::UNUSED, Scratch::E::COPY}}};
+
+  // implicit B (a convolution) is loaded element by element, from the image
+  if (emat == Mat::E::B && ptr_gg->conv.is_set())
+  {
+    edges[Chi::E::VEW] = {{1, {}}};
+    edges[Chi::E::WOS] = {{Scratch::E::UNUSED, {}}};
+  }
 }
 
 void CSuGr::initialise_edges()
@@ -532,7 +562,13 @@ void CSuGr::initialise_edges()
   edges[NonChi::E::GAL] = {
     {GroupAllocation::E::BYROW, {GroupAllocation::E::BYCOL, GroupAllocation::E::SUCOL}},
     {GroupAllocation::E::BYCOL, {GroupAllocation::E::BYROW, GroupAllocation::E::SUCOL}},
-    {GroupAllocation::E::SUCOL, {GroupAllocation::E::BYROW, GroupAllocation::E::BYCOL}}};
+    {GroupAllocation::E::SUCOL,
+     {GroupAllocation::E::BYROW,
+      GroupAllocation::E::BYCOL,
+      GroupAllocation::E::MORTON,
+      GroupAllocation::E::HILBERT}},
+    {GroupAllocation::E::MORTON, {GroupAllocation::E::SUCOL, GroupAllocation::E::HILBERT}},
+    {GroupAllocation::E::HILBERT, {GroupAllocation::E::SUCOL, GroupAllocation::E::MORTON}}};
 
   if (ptr_devinfo->wg_atom_size != 64 && ptr_devinfo->wg_atom_size != 32)
   {
@@ -590,6 +626,14 @@ void CSuGr::initialise_edges()
   edges[NonChi::E::MIA] = {g_binary()};
   edges[NonChi::E::SZT] = {g_binary()};
   edges[NonChi::E::MAD] = {g_binary()};
+  edges[NonChi::E::DBL] = {g_binary()};
+  edges[NonChi::E::PFR] = {g_binary()};
+  edges[NonChi::E::FUS] = {{0, {1, 2}}, {1, {0, 2}}, {2, {0, 1}}};
+
+  // stream-K : about 1, 2 or 4 persistent work groups per compute unit
+  size_t cu             = ptr_devinfo->device_max_compute_units;
+  edges[NonChi::E::STK] = {
+    {0, {cu}}, {cu, {0, 2 * cu}}, {2 * cu, {cu, 4 * cu}}, {4 * cu, {2 * cu}}};
 }
 
 void ChiSuGr::refine_start_range()
@@ -598,7 +642,7 @@ void ChiSuGr::refine_start_range()
   // start_range[Chi::E::LIW] = {Binary::E::NO};
   // start_range[Chi::E::MIW] = {Binary::E::YES};
 
-  if (ptr_gg->wSpaceSize == 0)
+  if (ptr_gg->wSpaceSize == 0 || (emat == Mat::E::B && ptr_gg->conv.is_set()))
   {
     start_range[Chi::E::WOS] = {Scratch::E::UNUSED};
   }
@@ -608,6 +652,7 @@ void ChiSuGr::refine_start_range()
   }
 
   start_range[Chi::E::VEW] = {1};
+  start_range[Chi::E::SWZ] = {Binary::E::NO};
 
   set_start_mic();
 }
@@ -618,6 +663,10 @@ void CSuGr::refine_start_range()
   start_range[NonChi::E::ICE] = {1};
   start_range[NonChi::E::UFO] = {Binary::E::NO};
   start_range[NonChi::E::SZT] = {Binary::E::NO};
+  start_range[NonChi::E::DBL] = {Binary::E::NO};
+  start_range[NonChi::E::PFR] = {Binary::E::NO};
+  start_range[NonChi::E::STK] = {0};
+  start_range[NonChi::E::FUS] = {0};
 
   if ((ptr_gg->m) > 200 && (ptr_gg->n) > 200)
   {
@@ -7,6 +7,8 @@
 #include <string>
 #include <miopengemm/enums.hpp>
 #include <miopengemm/kernelcache.hpp>
+#include <miopengemm/kernelcachefile.hpp>
+#include <miopengemm/nearest.hpp>
 #include <miopengemm/redirection.hpp>
 
 namespace MIOpenGEMM
@@ -24,6 +26,26 @@ std::vector<Geometry> get_geometries(const std::vector<CacheKey>& cks)
   return geometries;
 }
 
+KernelCache::KernelCache(const KernelCache& kc) : vals(kc.vals) {}
+
+KernelCache& KernelCache::operator=(const KernelCache& kc)
+{
+  std::lock_guard<std::mutex> lock(*index_mutex);
+  vals = kc.vals;
+  index.reset();
+  return *this;
+}
+
+std::shared_ptr<const nearest::Index> KernelCache::get_index() const
+{
+  std::lock_guard<std::mutex> lock(*index_mutex);
+  if (index == nullptr)
+  {
+    index = std::make_shared<const nearest::Index>(vals);
+  }
+  return index;
+}
+
 CacheKeyPresence KernelCache::check_for(const CacheKey& ckey) const
 {
   if (vals.count(ckey) == 0)
@@ -74,6 +96,86 @@ std::string CacheKey::get_string() const
   return ss.str();
 }
 
+#ifdef MIOPENGEMM_PREPARSED_CACHE
+namespace
+{
+// One entry of the builtin cache, as generated at build time from the .cachetxt files
+// (see python/cachetables.py), so that no strings are parsed at initialisation.
+struct PackedCacheEntry
+{
+  size_t device;       // index in builtin_devices
+  size_t constraints;  // index in builtin_constraints
+  bool   isColMajor;
+  bool   tA;
+  bool   tB;
+  bool   tC;
+  size_t m;
+  size_t n;
+  size_t k;
+  size_t lda;
+  size_t ldb;
+  size_t ldc;
+  size_t wSpaceSize;
+  char   floattype;
+  size_t chis[2][Chi::E::N];  // A and B
+  size_t nonchis[NonChi::E::N];
+};
+
+#include "cachetables.inc"
+
+template <size_t N>
+void confirm_keys(const char* const (&keys)[N], const EnumMapper<std::string>& mapper)
+{
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (N != mapper.N || mapper.name[i] != keys[i])
+    {
+      throw miog_error("The hyper-parameters of the generated cache tables are not those of "
+                       "this library (in the same order). Rebuild to regenerate them.");
+    }
+  }
+}
+}
+
+KernelCache init_kernel_cache()
+{
+  confirm_keys(builtin_chi_keys, Chi::M());
+  confirm_keys(builtin_nonchi_keys, NonChi::M());
+
+  std::vector<Constraints> constraints;
+  for (auto x : builtin_constraints)
+  {
+    constraints.emplace_back(x);
+  }
+
+  KernelCache kc;
+  for (auto& x : builtin_entries)
+  {
+    Geometry gg(x.isColMajor,
+                x.tA,
+                x.tB,
+                x.tC,
+                x.lda,
+                x.ldb,
+                x.ldc,
+                x.m,
+                x.n,
+                x.k,
+                x.wSpaceSize,
+                x.floattype);
+
+    std::array<SuHy, Mat::E::N> sus;
+    for (auto emat : {Mat::E::A, Mat::E::B})
+    {
+      sus[emat] = SuHy(emat, std::vector<size_t>(std::begin(x.chis[emat]), std::end(x.chis[emat])));
+    }
+    sus[Mat::E::C] = SuHy(Mat::E::C, std::vector<size_t>(std::begin(x.nonchis), std::end(x.nonchis)));
+
+    kc.add({builtin_devices[x.device], constraints[x.constraints], gg}, std::move(sus));
+  }
+  return kc;
+}
+#else
 KernelCache init_kernel_cache()
 {
   KernelCache kc;
@@ -84,10 +186,24 @@ KernelCache init_kernel_cache()
 #include "cache4.cachetxt"
   return kc;
 }
+#endif
+
+KernelCache init_layered_kernel_cache()
+{
+  KernelCache kc = init_kernel_cache();
+  for (auto& path : {cachefile::get_site_path(), cachefile::get_user_path()})
+  {
+    if (path != "")
+    {
+      cachefile::load(path, kc);
+    }
+  }
+  return kc;
+}
 
 const KernelCache& get_kernel_cache()
 {
-  static const KernelCache kc = init_kernel_cache();
+  static const KernelCache kc = init_layered_kernel_cache();
   return kc;
 }
 
@@ -132,6 +248,17 @@ void KernelCache::add(const CacheKey& ckey, const HyPas& hp)
     throw miog_error(ss.str());
   }
 
+  index.reset();
+  vals[ckey] = hp;
+}
+
+void KernelCache::set(const CacheKey& ckey, const HyPas& hp)
+{
+  if (redirection::get_is_not_canonical(ckey.gg))
+  {
+    throw miog_error("internal logic error : CacheKey has geometry in non-canonical form (in set)");
+  }
+  index.reset();
   vals[ckey] = hp;
 }
 
@@ -212,7 +339,13 @@ double CacheKey::get_distance(const CacheKey& ck) const
   distance += 1e-6 * (dvc != ck.dvc);
 
   // TODO : improved distance between constraints. will be non-sym.
-  distance += 1 * (constraints.get_string() != ck.constraints.get_string());
+  // (comparing ranges is equivalent to comparing constraint strings, without allocating)
+  bool same_constraints = true;
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    same_constraints &= (constraints.sub[emat].range == ck.constraints.sub[emat].range);
+  }
+  distance += 1 * (!same_constraints);
 
   return distance;
 }
@@ -0,0 +1,478 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <miopengemm/error.hpp>
+#include <miopengemm/kernelcachefile.hpp>
+
+namespace MIOpenGEMM
+{
+namespace cachefile
+{
+
+namespace
+{
+
+const char magic[6] = {'M', 'I', 'O', 'G', 'K', 'C'};
+// bump whenever the layout of a record or the set of HyPas keys changes, so that files written
+// by other versions are skipped rather than misread. 2 : DBL, PFR, SWZ, STK and FUS added.
+// 3 : the convolution of the geometry added.
+const uint16_t format_version = 3;
+const size_t   header_size    = sizeof(magic) + sizeof(format_version);
+const size_t   record_head    = 2 * sizeof(uint32_t);
+
+uint32_t get_checksum(const char* data, size_t n)
+{
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < n; ++i)
+  {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// files are loaded when the kernel cache is first used, where there is no owrite::Writer and
+// throwing would make every call fail : problems are reported here and the entries skipped.
+void warn(const std::string& x)
+{
+  std::cerr << "MIOpenGEMM warning : " << x << std::endl;
+}
+
+std::string get_env(const char* name)
+{
+  const char* x = std::getenv(name);
+  return x == nullptr ? "" : x;
+}
+
+template <typename T>
+void put(std::string& buffer, T x)
+{
+  buffer.append(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+
+void put_string(std::string& buffer, const std::string& x)
+{
+  if (x.size() > UINT16_MAX)
+  {
+    throw miog_error("string too long for kernel cache file : " + x);
+  }
+  put<uint16_t>(buffer, static_cast<uint16_t>(x.size()));
+  buffer.append(x);
+}
+
+std::string get_header()
+{
+  std::string header(magic, sizeof(magic));
+  put<uint16_t>(header, format_version);
+  return header;
+}
+
+std::string get_record(const CacheKey& ck, const HyPas& hp)
+{
+  const Geometry& gg = ck.gg;
+  std::string     payload;
+  uint8_t         flags = (gg.isColMajor ? 1 : 0) | (gg.tX[Mat::E::A] ? 2 : 0) |
+                  (gg.tX[Mat::E::B] ? 4 : 0) | (gg.tX[Mat::E::C] ? 8 : 0) |
+                  (gg.conv.is_set() ? 16 : 0);
+  put<uint8_t>(payload, flags);
+  put<uint8_t>(payload, static_cast<uint8_t>(gg.floattype));
+  put<uint16_t>(payload, 0);
+  for (size_t x : {gg.m,
+                   gg.n,
+                   gg.k,
+                   gg.ldX[Mat::E::A],
+                   gg.ldX[Mat::E::B],
+                   gg.ldX[Mat::E::C],
+                   gg.wSpaceSize})
+  {
+    put<uint64_t>(payload, x);
+  }
+  if (gg.conv.is_set())
+  {
+    const Convolution& conv = gg.conv;
+    for (size_t x : {static_cast<size_t>(conv.nhwc),
+                     conv.c,
+                     conv.h,
+                     conv.w,
+                     conv.r,
+                     conv.s,
+                     conv.pad_h,
+                     conv.pad_w,
+                     conv.stride_h,
+                     conv.stride_w,
+                     conv.dilation_h,
+                     conv.dilation_w})
+    {
+      put<uint64_t>(payload, x);
+    }
+  }
+  put_string(payload, ck.dvc);
+  put_string(payload, ck.constraints.get_string());
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    put_string(payload, hp.sus[emat].get_string());
+  }
+
+  std::string record;
+  put<uint32_t>(record, static_cast<uint32_t>(payload.size()));
+  put<uint32_t>(record, get_checksum(payload.data(), payload.size()));
+  return record + payload;
+}
+
+// Sequential reader of a payload, throwing if reading beyond its end.
+class Reader
+{
+  private:
+  const char* ptr;
+  const char* end;
+
+  public:
+  Reader(const char* ptr_, size_t n) : ptr(ptr_), end(ptr_ + n) {}
+
+  template <typename T>
+  T get()
+  {
+    if (ptr + sizeof(T) > end)
+    {
+      throw miog_error("kernel cache file record is shorter than expected");
+    }
+    T x;
+    std::memcpy(&x, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return x;
+  }
+
+  std::string get_string()
+  {
+    auto n = get<uint16_t>();
+    if (ptr + n > end)
+    {
+      throw miog_error("kernel cache file string is longer than its record");
+    }
+    std::string x(ptr, n);
+    ptr += n;
+    return x;
+  }
+};
+
+void add_record(const char* payload, size_t n, KernelCache& kc)
+{
+  Reader rd(payload, n);
+  auto   flags     = rd.get<uint8_t>();
+  auto   floattype = static_cast<char>(rd.get<uint8_t>());
+  rd.get<uint16_t>();
+  std::array<size_t, 7> v;
+  for (auto& x : v)
+  {
+    x = rd.get<uint64_t>();
+  }
+  Geometry gg(
+    flags & 1, flags & 2, flags & 4, flags & 8, v[3], v[4], v[5], v[0], v[1], v[2], v[6], floattype);
+  if (flags & 16)
+  {
+    std::array<size_t, 12> c;
+    for (auto& x : c)
+    {
+      x = rd.get<uint64_t>();
+    }
+    gg.conv = {c[0] != 0, c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8], c[9], c[10], c[11]};
+    gg.check_conv_consistent();
+  }
+
+  std::string dvc         = rd.get_string();
+  std::string constraints = rd.get_string();
+  std::array<std::string, Mat::E::N> hpstrings;
+  for (auto& x : hpstrings)
+  {
+    x = rd.get_string();
+  }
+  kc.set({dvc, constraints, gg}, hpstrings);
+}
+
+#ifndef _WIN32
+
+// Read-only memory map of a file, unmapped on destruction.
+class MappedFile
+{
+  public:
+  const char* data = nullptr;
+  size_t      size = 0;
+
+  MappedFile(const std::string& path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      void* x = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (x != MAP_FAILED)
+      {
+        data = static_cast<const char*>(x);
+        size = st.st_size;
+      }
+    }
+    ::close(fd);
+  }
+
+  ~MappedFile()
+  {
+    if (data != nullptr)
+    {
+      ::munmap(const_cast<char*>(data), size);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+
+void write_all(int fd, const std::string& x, const std::string& path)
+{
+  size_t done = 0;
+  while (done < x.size())
+  {
+    auto n = ::write(fd, x.data() + done, x.size() - done);
+    if (n < 0)
+    {
+      throw miog_error("failed to write to kernel cache file " + path);
+    }
+    done += n;
+  }
+}
+
+// Append record under an exclusive lock, with the header first if the file is new.
+void append_record(const std::string& path, std::string record)
+{
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0)
+  {
+    throw miog_error("failed to open kernel cache file for appending : " + path);
+  }
+
+  if (::flock(fd, LOCK_EX) != 0)
+  {
+    ::close(fd);
+    throw miog_error("failed to lock kernel cache file : " + path);
+  }
+
+  // a new (or empty) file gets the header, written together with the first record
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size == 0)
+  {
+    record = get_header() + record;
+  }
+
+  try
+  {
+    write_all(fd, record, path);
+  }
+  catch (const miog_error&)
+  {
+    ::flock(fd, LOCK_UN);
+    ::close(fd);
+    throw;
+  }
+
+  ::fsync(fd);
+  ::flock(fd, LOCK_UN);
+  ::close(fd);
+}
+
+std::string get_tmp_path(const std::string& path)
+{
+  return path + ".tmp" + std::to_string(::getpid());
+}
+
+void write_file(const std::string& path, const std::string& contents)
+{
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    throw miog_error("failed to open kernel cache file for writing : " + path);
+  }
+  write_all(fd, contents, path);
+  ::fsync(fd);
+  ::close(fd);
+}
+
+#else
+
+// Without mmap and flock : the file is read into memory, and appends are not locked, so
+// concurrent appends from several processes may interleave (and be skipped on load).
+class MappedFile
+{
+  private:
+  std::string contents;
+
+  public:
+  const char* data = nullptr;
+  size_t      size = 0;
+
+  MappedFile(const std::string& path)
+  {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.good())
+    {
+      return;
+    }
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (contents.size() > 0)
+    {
+      data = contents.data();
+      size = contents.size();
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+
+void append_record(const std::string& path, std::string record)
+{
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::app);
+  file.seekp(0, std::ios::end);
+  if (!file.good())
+  {
+    throw miog_error("failed to open kernel cache file for appending : " + path);
+  }
+  if (file.tellp() == 0)
+  {
+    record = get_header() + record;
+  }
+  file << record;
+  if (!file.good())
+  {
+    throw miog_error("failed to write to kernel cache file " + path);
+  }
+}
+
+std::string get_tmp_path(const std::string& path) { return path + ".tmp"; }
+
+void write_file(const std::string& path, const std::string& contents)
+{
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file << contents;
+  if (!file.good())
+  {
+    throw miog_error("failed to write kernel cache file : " + path);
+  }
+}
+
+#endif
+}
+
+std::string get_site_path() { return get_env("MIOPENGEMM_SITE_CACHE"); }
+std::string get_user_path() { return get_env("MIOPENGEMM_USER_CACHE"); }
+
+size_t load(const std::string& path, KernelCache& kc)
+{
+  MappedFile mf(path);
+  if (mf.data == nullptr)
+  {
+    return 0;
+  }
+
+  if (mf.size < header_size || std::memcmp(mf.data, magic, sizeof(magic)) != 0)
+  {
+    warn("not a kernel cache file, ignoring it : " + path);
+    return 0;
+  }
+
+  uint16_t version;
+  std::memcpy(&version, mf.data + sizeof(magic), sizeof(version));
+  if (version != format_version)
+  {
+    std::stringstream ss;
+    ss << "kernel cache file " << path << " has format version " << version << ", expected "
+       << format_version << ". Ignoring it (remove it, or rewrite it with this version).";
+    warn(ss.str());
+    return 0;
+  }
+
+  size_t n_records = 0;
+  size_t offset    = header_size;
+  while (offset + record_head <= mf.size)
+  {
+    uint32_t payload_size;
+    uint32_t checksum;
+    std::memcpy(&payload_size, mf.data + offset, sizeof(uint32_t));
+    std::memcpy(&checksum, mf.data + offset + sizeof(uint32_t), sizeof(uint32_t));
+    const char* payload = mf.data + offset + record_head;
+
+    // a truncated final record is the remains of an interrupted append, and is ignored
+    if (offset + record_head + payload_size > mf.size)
+    {
+      break;
+    }
+
+    std::stringstream where;
+    where << "record at byte " << offset << " of kernel cache file " << path;
+    offset += record_head + payload_size;
+
+    if (get_checksum(payload, payload_size) != checksum)
+    {
+      warn("skipping corrupt " + where.str());
+      continue;
+    }
+
+    try
+    {
+      add_record(payload, payload_size, kc);
+      ++n_records;
+    }
+    catch (const miog_error& e)
+    {
+      warn("skipping invalid " + where.str() + " : " + e.what());
+    }
+  }
+  return n_records;
+}
+
+void append(const std::string& path, const CacheKey& ck, const HyPas& hp)
+{
+  append_record(path, get_record(ck, hp));
+}
+
+void write(const std::string& path, const KernelCache& kc)
+{
+  std::string contents = get_header();
+  for (auto& ck : kc.get_keys())
+  {
+    contents += get_record(ck, kc.at(ck));
+  }
+
+  std::string tmp_path = get_tmp_path(path);
+  write_file(tmp_path, contents);
+
+#ifdef _WIN32
+  // rename does not replace an existing file here
+  std::remove(path.c_str());
+#endif
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+  {
+    std::remove(tmp_path.c_str());
+    throw miog_error("failed to rename " + tmp_path + " to " + path);
+  }
+}
+}
+}
@@ -2,9 +2,20 @@
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <miopengemm/kernelcachefile.hpp>
 #include <miopengemm/kernelcachemerge.hpp>
 #include <miopengemm/setabcw.hpp>
 #include <miopengemm/tinytwo.hpp>
@@ -12,205 +23,608 @@
 namespace MIOpenGEMM
 {
 
-namespace canonical
+namespace
 {
-// no swaps when canonical
-const bool noswap = false;
+
+// Contender ci runs in position (ci + n - rotation) % n of round r, where the rotation is the
+// digit sum of r in base n (mod n). For n = 2 this is the Thue–Morse sequence ABBABAAB,
+// for a fair penalty shoot-out. For larger n, each contender runs in each position equally often.
+size_t get_thue_morse_rotation(size_t r, size_t n)
+{
+  size_t digit_sum = 0;
+  for (; r > 0; r /= n)
+  {
+    digit_sum += r % n;
+  }
+  return digit_sum % n;
 }
 
-// sequence for a fair penalty shoot-out.
-std::vector<bool> get_thue_morse(size_t length)
+double get_median(std::vector<double> x)
 {
-  std::vector<bool> thue_morse{true, false};
-  while (thue_morse.size() < length)
+  if (x.empty())
   {
-    for (auto x : thue_morse)
-    {
-      thue_morse.push_back(!x);
-    }
+    return 0;
+  }
+  std::sort(x.begin(), x.end());
+  return x.size() % 2 == 1 ? x[x.size() / 2] : 0.5 * (x[x.size() / 2 - 1] + x[x.size() / 2]);
+}
+
+// two-sided sign test : the probability of a split at least as uneven as wins:losses,
+// were both equally likely to win a round.
+double get_sign_test_p(size_t wins, size_t losses)
+{
+  size_t n = wins + losses;
+  size_t k = std::min(wins, losses);
+  double p = 0;
+  for (size_t i = 0; i <= k; ++i)
+  {
+    p += std::exp(std::lgamma(n + 1.) - std::lgamma(i + 1.) - std::lgamma(n - i + 1.) -
+                  n * std::log(2.));
   }
-  thue_morse.resize(length);
-  return thue_morse;
+  return std::min(1., 2 * p);
 }
 
+// the 0.975 quantile of Student's t distribution with df degrees of freedom
+double get_t975(size_t df)
+{
+  static const std::vector<double> t975{
+    12.71, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228};
+  return df <= t975.size() ? t975[df - 1] : 1.96 + 2.4 / df;
+}
+
+// 95% confidence interval of the geometric mean of the ratios x / y
+std::array<double, 2> get_ratio_ci(const std::vector<double>& x, const std::vector<double>& y)
+{
+  std::vector<double> logs;
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    logs.push_back(std::log(x[i] / y[i]));
+  }
+  if (logs.empty())
+  {
+    return {{1, 1}};
+  }
+  double mean = std::accumulate(logs.begin(), logs.end(), 0.) / logs.size();
+  if (logs.size() == 1)
+  {
+    return {{std::exp(mean), std::exp(mean)}};
+  }
+  double var = 0;
+  for (auto l : logs)
+  {
+    var += (l - mean) * (l - mean) / (logs.size() - 1);
+  }
+  double half = get_t975(logs.size() - 1) * std::sqrt(var / logs.size());
+  return {{std::exp(mean - half), std::exp(mean + half)}};
+}
+
+// A cache key on which the caches disagree
+class Dispute
+{
+  public:
+  CacheKey ck;
+  // the distinct solutions of the caches
+  std::vector<HyPas> hps;
+  // for each cache, the index in hps of its solution, or hps.size() if it has no entry
+  std::vector<size_t> of_cache;
+};
+
+// The kernels of one contender (a distinct solution for a key), compiled on construction.
 template <typename TFl>
-void populate(const std::vector<CacheKey>& cache_keys,
-              const KernelCache&           kc1,
-              const KernelCache&           kc2,
-              KernelCache&                 kc,
-              const Halt&                  halt,
-              owrite::Writer&              mowri)
+class Contender
 {
+  public:
+  HyPas hp;
+  bool  is_derivable;
 
-  Offsets offsets = get_zero_offsets();
-  CLHint  xhint;
+  private:
+  std::unique_ptr<dev::TinyOne<TFl>> diva;
+  std::unique_ptr<TinyZero>          simdiva;
 
-  // we set the CPU memory once for all geometries.
-  // This is much faster than once for each geometry using TinyTwos
-  mowri.bw[OutPart::MER] << "generating random matrices on CPU ... " << Flush;
-  setabcw::CpuMemBundle<TFl> cmb(get_geometries(cache_keys), offsets);
-  mowri.bw[OutPart::MER] << "done. Will perform Thue–Morse ABBABAAB 1-on-1." << Endl;
-  for (size_t i = 0; i < cache_keys.size(); ++i)
+  public:
+  Contender(const CacheKey&                    ck,
+            const HyPas&                       hp_,
+            const CLHint&                      hint,
+            std::shared_ptr<simdevice::Device> simdev,
+            std::array<const TFl*, Mat::E::N>  r_mem,
+            const Offsets&                     offsets,
+            owrite::Writer&                    mowri)
+    : hp(hp_), is_derivable(Derivabilty(hp, ck.gg).is_derivable)
   {
-    auto ck = cache_keys[i];
-    if (kc1.at(ck, canonical::noswap) == kc2.at(ck, canonical::noswap))
+    if (!is_derivable)
+    {
+      return;
+    }
+    if (simdev != nullptr)
+    {
+      simdiva.reset(new TinyZero(simdev, ck.gg, offsets, mowri));
+      simdiva->compile(hp);
+    }
+    else
     {
-      kc.add(ck, kc1.at(ck, canonical::noswap));
-      mowri.bw[OutPart::MER] << "[ss]" << Flush;
-      continue;
+      diva.reset(new dev::TinyOne<TFl>(ck.gg, offsets, r_mem, mowri, hint));
+      diva->compile(hp);
     }
-    mowri.bw[OutPart::MER] << '\n' << "(" << i << " / " << cache_keys.size() << ")";
-    mowri.bw[OutPart::MER] << ck.gg.get_string() << Endl;
+  }
 
-    mowri.bw[OutPart::MER] << "soln1 : " << kc1.at(ck, canonical::noswap).get_string() << Endl;
-    mowri.bw[OutPart::MER] << "soln2 : " << kc2.at(ck, canonical::noswap).get_string() << Endl;
+  // the fastest of the runs of a call to benchgemm, or 1e8 if not derivable
+  double get_time(const Halt& halt)
+  {
+    if (!is_derivable)
+    {
+      return 1e8;
+    }
+    std::vector<double> ltimes =
+      simdiva != nullptr ? simdiva->benchgemm(hp, halt) : diva->benchgemm({hp}, halt).back();
+    return *std::min_element(ltimes.begin(), ltimes.end());
+  }
+};
 
-    // having two TinyOnes means that each opposing kernel only needs be compiled once. Optional.
-    dev::TinyOne<TFl> diva1(ck.gg, offsets, cmb.r_mem, mowri, xhint);
-    dev::TinyOne<TFl> diva2(ck.gg, offsets, cmb.r_mem, mowri, xhint);
+template <typename TFl>
+using Contenders = std::vector<std::unique_ptr<Contender<TFl>>>;
 
-    mowri.bw[OutPart::MER] << "Two divas generated" << Endl;
+// Decides the disputes, in parallel over the devices of mparms.
+template <typename TFl>
+class Merger
+{
+  private:
+  const std::vector<Dispute>& disputes;
+  KernelCache&                kc;
+  const Halt&                 halt;
+  const MergeParams&          mparms;
+  owrite::Writer&             mowri;
+  MergeReport&                report;
 
-    std::vector<double> times_kc1;
-    std::vector<double> times_kc2;
+  Offsets                                     offsets = get_zero_offsets();
+  std::unique_ptr<setabcw::CpuMemBundle<TFl>> cmb;
+  std::array<const TFl*, Mat::E::N>           r_mem{};
 
-    size_t kc1_wins = 0;
-    size_t kc2_wins = 0;
+  std::mutex          mutex;
+  std::atomic<size_t> next{0};
+  size_t              n_decided{0};
 
-    std::string prefix = std::to_string(i) + "/" + std::to_string(cache_keys.size());
-    prefix.resize(8, ' ');
+  Contenders<TFl> get_contenders(const Dispute&                     dispute,
+                                 const CLHint&                      hint,
+                                 std::shared_ptr<simdevice::Device> simdev,
+                                 owrite::Writer&                    silent)
+  {
+    Contenders<TFl> contenders;
+    for (auto& hp : dispute.hps)
+    {
+      contenders.emplace_back(
+        new Contender<TFl>(dispute.ck, hp, hint, simdev, r_mem, offsets, silent));
+    }
+    return contenders;
+  }
+
+  void decide(const Dispute& dispute, Contenders<TFl>& contenders)
+  {
+    const CacheKey& ck = dispute.ck;
+    size_t          n  = contenders.size();
 
-    auto act_kcx = [&halt, &mowri, &ck, &prefix](const KernelCache& kcx,
-                                                 std::string          frag,
-                                                 std::vector<double>& times,
-                                                 dev::TinyOne<TFl>&   diva) {
-      mowri.bw[OutPart::MER] << '<' << frag << Flush;
-      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    // times[r][ci] of contender ci in round r, -1 if eliminated
+    std::vector<std::vector<double>> times;
+    // wins[ci][cj] : number of rounds in which ci was faster than cj
+    std::vector<std::vector<size_t>> wins(n, std::vector<size_t>(n, 0));
+    std::vector<bool> alive(n, true);
 
-      auto        hp = kcx.at(ck, canonical::noswap);
-      Derivabilty drvble(hp, ck.gg);
-      double      zoo;
-      if (drvble.is_derivable)
+    for (size_t r = 0; r < mparms.max_rounds && std::count(alive.begin(), alive.end(), true) > 1;
+         ++r)
+    {
+      std::vector<double> round(n, -1);
+      size_t              rotation = get_thue_morse_rotation(r, n);
+      for (size_t pos = 0; pos < n; ++pos)
       {
-        std::vector<double> ltimes = diva.benchgemm({hp}, halt).back();
-        zoo                        = *std::min_element(ltimes.begin(), ltimes.end());
+        size_t ci = (pos + rotation) % n;
+        if (!alive[ci])
+        {
+          continue;
+        }
+        if (mparms.pause > 0)
+        {
+          std::this_thread::sleep_for(std::chrono::duration<double>(mparms.pause));
+        }
+        round[ci] = contenders[ci]->get_time(halt);
       }
-      else
+      times.push_back(round);
+
+      for (size_t ci = 0; ci < n; ++ci)
       {
-        zoo = 1e8;
+        for (size_t cj = 0; cj < n; ++cj)
+        {
+          wins[ci][cj] += (alive[ci] && alive[cj] && round[ci] < round[cj]);
+        }
       }
-      mowri.bw[OutPart::MER] << '>' << Flush;
 
-      times.push_back(zoo);
-    };
+      // eliminate the clearly dominated, unless that would eliminate all (a cycle)
+      std::vector<bool> dominated(n, false);
+      for (size_t ci = 0; ci < n; ++ci)
+      {
+        for (size_t cj = 0; cj < n; ++cj)
+        {
+          dominated[ci] = dominated[ci] || (alive[ci] && alive[cj] &&
+                                            wins[cj][ci] > wins[ci][cj] + mparms.margin);
+        }
+      }
+      std::vector<bool> next_alive(n);
+      for (size_t ci = 0; ci < n; ++ci)
+      {
+        next_alive[ci] = alive[ci] && !dominated[ci];
+      }
+      if (std::count(next_alive.begin(), next_alive.end(), true) > 0)
+      {
+        alive = next_alive;
+      }
+    }
 
-    for (auto kc1_first : get_thue_morse(14))
+    std::vector<double> medians(n);
+    for (size_t ci = 0; ci < n; ++ci)
     {
-      if (kc1_first)
+      std::vector<double> ran;
+      for (auto& round : times)
       {
-        act_kcx(kc1, "1", times_kc1, diva1);
-        act_kcx(kc2, "2", times_kc2, diva1);
+        if (round[ci] >= 0)
+        {
+          ran.push_back(round[ci]);
+        }
       }
-      else
+      medians[ci] = get_median(ran);
+    }
+
+    // of the remaining, the most head-to-head wins against the others remaining, then fastest
+    auto get_score = [&wins, &alive, n](size_t ci) {
+      size_t score = 0;
+      for (size_t cj = 0; cj < n; ++cj)
+      {
+        score += (alive[cj] && wins[ci][cj] > wins[cj][ci]);
+      }
+      return score;
+    };
+    size_t winner = n;
+    for (size_t ci = 0; ci < n; ++ci)
+    {
+      if (alive[ci] && (winner == n || get_score(ci) > get_score(winner) ||
+                        (get_score(ci) == get_score(winner) && medians[ci] < medians[winner])))
+      {
+        winner = ci;
+      }
+    }
+    size_t runner_up = n;
+    for (size_t ci = 0; ci < n; ++ci)
+    {
+      if (ci != winner && (runner_up == n || medians[ci] < medians[runner_up]))
+      {
+        runner_up = ci;
+      }
+    }
+
+    std::vector<double> t_winner;
+    std::vector<double> t_runner_up;
+    for (auto& round : times)
+    {
+      if (round[winner] >= 0 && round[runner_up] >= 0)
       {
-        act_kcx(kc2, "2", times_kc2, diva1);
-        act_kcx(kc1, "1", times_kc1, diva1);
+        t_winner.push_back(round[winner]);
+        t_runner_up.push_back(round[runner_up]);
       }
-      mowri.bw[OutPart::MER] << '|' << Flush;
+    }
+
+    // a cache proposing contender ci
+    auto get_cache = [&dispute](size_t ci) {
+      return static_cast<size_t>(
+        std::find(dispute.of_cache.begin(), dispute.of_cache.end(), ci) - dispute.of_cache.begin());
+    };
 
-      kc1_wins += (times_kc1.back() < times_kc2.back());
-      kc2_wins += (times_kc2.back() < times_kc1.back());
+    MergeRecord record{ck,
+                       {},
+                       get_cache(winner),
+                       get_cache(runner_up),
+                       times.size(),
+                       get_sign_test_p(wins[winner][runner_up], wins[runner_up][winner]),
+                       get_ratio_ci(t_runner_up, t_winner)};
+    for (auto ci : dispute.of_cache)
+    {
+      record.gflops.push_back(ci < n ? ck.gg.get_gflops(medians[ci] / 1000.) : 0);
+    }
 
-      if (kc1_wins > kc2_wins + 5 || kc2_wins > kc1_wins + 5)
+    std::stringstream ss;
+    ss << ck.gg.get_string() << '\n';
+    for (size_t ci = 0; ci < n; ++ci)
+    {
+      ss << "soln" << ci + 1 << " : " << contenders[ci]->hp.get_string() << '\n';
+    }
+    for (auto& round : times)
+    {
+      for (size_t ci = 0; ci < n; ++ci)
       {
-        break;
+        ss << (round[ci] < 0 ? std::string(8, '-')
+                             : stringutil::get_char_padded(ck.gg.get_gflops(round[ci] / 1000.), 8))
+           << (ci + 1 < n ? " \t " : "\n");
       }
     }
+    ss << "soln" << winner + 1 << " (of kc" << record.winner + 1 << ") won after " << times.size()
+       << " rounds. Against soln" << runner_up + 1 << " : " << wins[winner][runner_up] << ':'
+       << wins[runner_up][winner] << ", p = " << record.p_value << ", speed-up in ["
+       << record.speedup_ci[0] << ", " << record.speedup_ci[1] << "].";
+
+    add(ck, contenders[winner]->hp, ss.str(), record);
+  }
 
-    mowri.bw[OutPart::MER] << Endl;
-    for (unsigned ri = 0; ri < times_kc1.size(); ++ri)
+  void add(const CacheKey& ck, const HyPas& hp, const std::string& msg, const MergeRecord& record)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    kc.add(ck, hp);
+    if (mparms.journal != "")
     {
-      auto g1 = ck.gg.get_gflops(times_kc1[ri]);
-      auto g2 = ck.gg.get_gflops(times_kc2[ri]);
+      cachefile::append(mparms.journal, ck, hp);
+    }
+    report.records.push_back(record);
+    ++n_decided;
+    mowri.bw[OutPart::MER] << '\n'
+                           << "(" << n_decided << " / " << disputes.size() << ") " << msg << Endl;
+  }
 
-      mowri.bw[OutPart::MER] << stringutil::get_char_padded(g1, 8) << " \t ";
-      if (g1 > g2)
+  // compile the contenders of the next key while benchmarking those of the current key
+  void work(const CLHint& hint, std::shared_ptr<simdevice::Device> simdev)
+  {
+    owrite::Writer silent(Ver::E::SILENT, "");
+    auto prepare = [this, &hint, simdev, &silent](size_t i) {
+      return get_contenders(disputes[i], hint, simdev, silent);
+    };
+
+    size_t i = next++;
+    if (i >= disputes.size())
+    {
+      return;
+    }
+    auto current = prepare(i);
+    while (true)
+    {
+      size_t                       j = next++;
+      std::future<Contenders<TFl>> ahead;
+      if (j < disputes.size())
       {
-        mowri.bw[OutPart::MER] << '>';
+        ahead = std::async(std::launch::async, prepare, j);
       }
-      else
+      decide(disputes[i], current);
+      if (j >= disputes.size())
       {
-        mowri.bw[OutPart::MER] << "<=";
+        break;
       }
-      mowri.bw[OutPart::MER] << " \t " << stringutil::get_char_padded(g2, 8) << Endl;
+      current = ahead.get();
+      i       = j;
     }
+  }
+
+  public:
+  Merger(const std::vector<Dispute>& disputes_,
+         KernelCache&                kc_,
+         const Halt&                 halt_,
+         const MergeParams&          mparms_,
+         owrite::Writer&             mowri_,
+         MergeReport&                report_)
+    : disputes(disputes_), kc(kc_), halt(halt_), mparms(mparms_), mowri(mowri_), report(report_)
+  {
+  }
 
-    if (kc1_wins > kc2_wins)
+  void run()
+  {
+    if (disputes.empty())
     {
-      mowri.bw[OutPart::MER] << "kc1 won, " << kc1_wins << ':' << kc2_wins << '.' << '\n';
-      kc.add(ck, kc1.at(ck, canonical::noswap));
+      return;
     }
-    else
+
+    size_t n_workers = mparms.simdevs.empty() ? mparms.hints.size() : mparms.simdevs.size();
+    if (n_workers == 0)
     {
-      mowri.bw[OutPart::MER] << "kc2 won, " << kc2_wins << ':' << kc1_wins << '.' << '\n';
-      kc.add(ck, kc2.at(ck, canonical::noswap));
+      throw miog_error("no devices (hints or simulated devices) in MergeParams");
+    }
+
+    if (mparms.simdevs.empty())
+    {
+      // we set the CPU memory once for all geometries.
+      // This is much faster than once for each geometry using TinyTwos
+      std::vector<Geometry> geometries;
+      for (auto& x : disputes)
+      {
+        geometries.push_back(x.ck.gg);
+      }
+      mowri.bw[OutPart::MER] << "generating random matrices on CPU ... " << Flush;
+      cmb.reset(new setabcw::CpuMemBundle<TFl>(geometries, offsets));
+      r_mem = cmb->r_mem;
+      mowri.bw[OutPart::MER] << "done. " << Flush;
+    }
+    mowri.bw[OutPart::MER] << "Will perform Thue–Morse tournaments on " << disputes.size()
+                           << " keys, with " << n_workers << " worker(s)." << Endl;
+
+    std::vector<std::future<void>> workers;
+    for (size_t wi = 0; wi < n_workers; ++wi)
+    {
+      CLHint hint = mparms.simdevs.empty() ? mparms.hints[wi] : CLHint();
+      auto   sim  = mparms.simdevs.empty() ? nullptr : mparms.simdevs[wi];
+      workers.push_back(std::async(std::launch::async, [this, hint, sim]() { work(hint, sim); }));
+    }
+    // get rethrows any exception of a worker
+    for (auto& w : workers)
+    {
+      w.get();
     }
     mowri.bw[OutPart::MER] << '\n';
   }
-
-  mowri.bw[OutPart::MER] << '\n';
+};
 }
 
-KernelCache
-get_merged(const KernelCache& kc1, const KernelCache& kc2, const Halt& halt, owrite::Writer& mowri)
+double MergeRecord::get_gain(size_t ci) const
 {
+  return gflops[ci] > 0 ? gflops[winner] / gflops[ci] - 1 : 0;
+}
 
-  KernelCache kc;
-  std::map<char, std::vector<CacheKey>> in_both;
-
-  size_t from_kc1{0};
-  size_t from_kc2{0};
-  size_t undetermined{0};
-  for (auto& k1 : kc1.get_keys())
+std::string MergeReport::get_string() const
+{
+  std::stringstream ss;
+  ss << "geometry  rounds  winner  runner-up  p  speed-up(95% CI)  GFlops(per cache)  "
+        "gain(per cache)\n";
+  for (auto& x : records)
   {
-    if (!kc2.check_for(k1).is_present)
+    ss << x.ck.gg.get_string() << "  " << x.rounds << "  kc" << x.winner + 1 << "  kc"
+       << x.runner_up + 1 << "  " << x.p_value << "  [" << x.speedup_ci[0] << ", "
+       << x.speedup_ci[1] << "] ";
+    for (auto g : x.gflops)
     {
-      kc.add(k1, kc1.at(k1, canonical::noswap));
-      ++from_kc1;
+      ss << ' ' << g;
     }
-    else
+    ss << ' ';
+    for (size_t ci = 0; ci < n_caches; ++ci)
     {
-      if (in_both.count(k1.gg.floattype) == 0)
+      ss << ' ' << 100 * x.get_gain(ci) << '%';
+    }
+    ss << '\n';
+  }
+
+  ss << "\nper cache, over the " << records.size() << " geometries decided by tournament :\n";
+  for (size_t ci = 0; ci < n_caches; ++ci)
+  {
+    size_t present = 0;
+    size_t won     = 0;
+    double log_sum = 0;
+    for (auto& x : records)
+    {
+      if (x.gflops[ci] > 0)
       {
-        in_both[k1.gg.floattype] = {};
+        ++present;
+        won += (x.gflops[ci] == x.gflops[x.winner]);
+        log_sum += std::log(1 + x.get_gain(ci));
       }
-      in_both[k1.gg.floattype].push_back(k1);
-      ++undetermined;
     }
+    ss << "kc" << ci + 1 << " : present for " << present << ", won " << won
+       << ", geometric mean gain of merge " << 100 * (present > 0 ? std::exp(log_sum / present) - 1 : 0)
+       << "%\n";
+  }
+  return ss.str();
+}
+
+template <typename TFl>
+void populate(const std::vector<Dispute>& disputes,
+              KernelCache&                kc,
+              const Halt&                 halt,
+              const MergeParams&          mparms,
+              owrite::Writer&             mowri,
+              MergeReport&                report)
+{
+  Merger<TFl>(disputes, kc, halt, mparms, mowri, report).run();
+}
+
+KernelCache
+get_merged(const KernelCache& kc1, const KernelCache& kc2, const Halt& halt, owrite::Writer& mowri)
+{
+  return get_merged(kc1, kc2, halt, MergeParams(), mowri);
+}
+
+KernelCache get_merged(const KernelCache& kc1,
+                       const KernelCache& kc2,
+                       const Halt&        halt,
+                       const MergeParams& mparms,
+                       owrite::Writer&    mowri)
+{
+  MergeReport report;
+  return get_merged({&kc1, &kc2}, halt, mparms, mowri, report);
+}
+
+KernelCache get_merged(const std::vector<const KernelCache*>& kcs,
+                       const Halt&                            halt,
+                       const MergeParams&                     mparms,
+                       owrite::Writer&                        mowri,
+                       MergeReport&                           report)
+{
+
+  KernelCache kc;
+  report = MergeReport();
+  report.n_caches = kcs.size();
+  std::map<char, std::vector<Dispute>> disputes;
+
+  // entries decided by an earlier (interrupted) merge
+  KernelCache journaled;
+  if (mparms.journal != "")
+  {
+    cachefile::load(mparms.journal, journaled);
   }
 
-  for (auto& k2 : kc2.get_keys())
+  size_t                          unique{0};
+  size_t                          identical{0};
+  size_t                          resumed{0};
+  size_t                          undetermined{0};
+  std::unordered_set<std::string> seen;
+  for (auto kcx : kcs)
   {
-    if (!kc1.check_for(k2).is_present)
+    for (auto& ck : kcx->get_keys())
     {
-      kc.add(k2, kc2.at(k2, canonical::noswap));
-      ++from_kc2;
+      if (!seen.insert(ck.concatenated).second)
+      {
+        continue;
+      }
+
+      Dispute dispute{ck, {}, {}};
+      size_t  present = 0;
+      for (auto kcy : kcs)
+      {
+        size_t ci = std::numeric_limits<size_t>::max();
+        if (kcy->contains(ck))
+        {
+          ++present;
+          auto& hp = kcy->at(ck);
+          ci = std::find(dispute.hps.begin(), dispute.hps.end(), hp) - dispute.hps.begin();
+          if (ci == dispute.hps.size())
+          {
+            dispute.hps.push_back(hp);
+          }
+        }
+        dispute.of_cache.push_back(ci);
+      }
+      // caches without an entry point past the end of hps
+      for (auto& ci : dispute.of_cache)
+      {
+        ci = std::min(ci, dispute.hps.size());
+      }
+
+      if (dispute.hps.size() == 1)
+      {
+        kc.add(ck, dispute.hps[0]);
+        ++(present == 1 ? unique : identical);
+      }
+      // only if the journaled entry is one of the contenders, it may be from another merge
+      else if (journaled.contains(ck) &&
+               std::find(dispute.hps.begin(), dispute.hps.end(), journaled.at(ck)) !=
+                 dispute.hps.end())
+      {
+        kc.add(ck, journaled.at(ck));
+        ++resumed;
+      }
+      else
+      {
+        disputes[ck.gg.floattype].push_back(std::move(dispute));
+        ++undetermined;
+      }
     }
   }
 
-  mowri.bw[OutPart::MER] << "from kc1 : " << from_kc1 << ", from kc2 : " << from_kc2
+  mowri.bw[OutPart::MER] << "in one cache : " << unique << ", identical : " << identical
+                         << ", from journal : " << resumed
                          << ", to be determined : " << undetermined << Endl;
 
-  for (auto& x : in_both)
+  for (auto& x : disputes)
   {
     switch (std::get<0>(x))
     {
-    case 'f': populate<float>(in_both['f'], kc1, kc2, kc, halt, mowri); break;
-    case 'd': populate<double>(in_both['f'], kc1, kc2, kc, halt, mowri); break;
+    case 'f': populate<float>(std::get<1>(x), kc, halt, mparms, mowri, report); break;
+    case 'd': populate<double>(std::get<1>(x), kc, halt, mparms, mowri, report); break;
     default: throw miog_error("unrecognised floattype in get_merged");
     }
   }
 
+  if (!report.records.empty())
+  {
+    mowri.bw[OutPart::MER] << report.get_string() << Endl;
+  }
   return kc;
 }
 
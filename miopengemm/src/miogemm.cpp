@@ -9,6 +9,7 @@
 #include <miopengemm/nearest.hpp>
 #include <miopengemm/redirection.hpp>
 #include <miopengemm/timer.hpp>
+#include <miopengemm/tinygenerator.hpp>
 #include <miopengemm/tinyzero.hpp>
 
 namespace MIOpenGEMM
@@ -21,23 +22,23 @@ HyPas get_generic(const Geometry& gg, const Constraints& constraints)
 
   if (gg.m >= 1000 && gg.n >= 1000)
   {
-    hp = {{{"MIC5_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1",
-            "MIC4_PAD2_PLU0_LIW0_MIW1_WOS0_VEW1",
-            "UNR16_GAL1_PUN0_ICE1_IWI0_SZT0_NAW64_UFO0_MAC256_SKW10_AFI1_MIA1_MAD0"}}};
+    hp = {{{"MIC5_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1_SWZ0",
+            "MIC4_PAD2_PLU0_LIW0_MIW1_WOS0_VEW1_SWZ0",
+            "UNR16_GAL1_PUN0_ICE1_IWI0_SZT0_NAW64_UFO0_MAC256_SKW10_AFI1_MIA1_MAD0_DBL0_PFR0_STK0_FUS0"}}};
   }
 
   else if (gg.m >= 100 && gg.n >= 100)
   {
-    hp = {{{"MIC1_PAD0_PLU0_LIW0_MIW1_WOS0_VEW1",
-            "MIC2_PAD1_PLU0_LIW1_MIW0_WOS0_VEW1",
-            "UNR64_GAL3_PUN1_ICE1_IWI1_SZT0_NAW16_UFO0_MAC64_SKW10_AFI1_MIA1_MAD0"}}};
+    hp = {{{"MIC1_PAD0_PLU0_LIW0_MIW1_WOS0_VEW1_SWZ0",
+            "MIC2_PAD1_PLU0_LIW1_MIW0_WOS0_VEW1_SWZ0",
+            "UNR64_GAL3_PUN1_ICE1_IWI1_SZT0_NAW16_UFO0_MAC64_SKW10_AFI1_MIA1_MAD0_DBL0_PFR0_STK0_FUS0"}}};
   }
 
   else
   {
-    hp = {{{"MIC1_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1",
-            "MIC1_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1",
-            "UNR4_GAL1_PUN0_ICE1_IWI0_SZT1_NAW64_UFO0_MAC1_SKW10_AFI0_MIA0_MAD0"}}};
+    hp = {{{"MIC1_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1_SWZ0",
+            "MIC1_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1_SWZ0",
+            "UNR4_GAL1_PUN0_ICE1_IWI0_SZT1_NAW64_UFO0_MAC1_SKW10_AFI0_MIA0_MAD0_DBL0_PFR0_STK0_FUS0"}}};
   }
 
   hp.replace_where_defined(constraints);
@@ -61,7 +62,8 @@ Solution get_default_soln(const oclutil::DevInfo& devinfo,
                           size_t                  rank)
 {
 
-  double extime = 0;
+  double extime      = 0;
+  bool   exact_match = false;
   HyPas  hp;
 
   auto&& kernel_cache = get_kernel_cache();
@@ -82,6 +84,7 @@ Solution get_default_soln(const oclutil::DevInfo& devinfo,
     auto nearest_ck       = nearest::get(ck, graph, kernel_cache, rank);
     bool is_not_canonical = redirection::get_is_not_canonical(gg);
     hp                    = kernel_cache.at(nearest_ck, is_not_canonical);
+    exact_match           = nearest_ck == ck;
 
     mowri << "Nearest match in kernel cache:\n" << nearest_ck.get_string() << Flush;
   }
@@ -104,6 +107,17 @@ Solution get_default_soln(const oclutil::DevInfo& devinfo,
 
   kerngen::Bundle bundle(hp, gg);  //, mowri);
 
+  // for tiny geometries, the launches of the workspace, beta and main kernels dominate. A tuned
+  // (exactly matching) cache entry is trusted, and the tiny kernel ignores constraints.
+  if (tinygen::is_tiny(gg) && !exact_match && constraints.get_string().empty())
+  {
+    mowri << "Tiny geometry, using the single tiny kernel.\n";
+    std::vector<KernBlob> v_tiny{tinygen::get_tiny_kernelstring(hp, gg, bundle.dp)};
+    Solution soln(gg, extime, v_tiny, hp, devinfo, constraints);
+    soln.is_tiny = true;
+    return soln;
+  }
+
   return {gg, extime, bundle.v_tgks, hp, devinfo, constraints};
 }
 
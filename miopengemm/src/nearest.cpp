@@ -3,6 +3,9 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <miopengemm/nearest.hpp>
 
 namespace MIOpenGEMM
@@ -10,73 +13,225 @@ namespace MIOpenGEMM
 namespace nearest
 {
 
-bool is_within(
-  const CacheKey& ck, const Graph& graph, const KernelCache& kc, double threshold, size_t rank)
+namespace
+{
+
+// Geometry::get_distance is the L1 distance between metric_co's, plus non-negative terms,
+// plus a signed workspace term 1e-5*(log(ws1 + 1.1) - log(ws2 + 1.1)), which is never below:
+const double ws_slack = 1e-5 * std::log(std::pow(2., 64));
+
+double get_l1(const std::array<double, 6>& a, const std::array<double, 6>& b)
+{
+  double d = 0;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    d += std::abs(a[i] - b[i]);
+  }
+  return d;
+}
+
+void build_vp_tree(std::vector<IndexEntry>& entries, size_t lo, size_t hi)
+{
+  if (lo == hi)
+  {
+    return;
+  }
+
+  IndexEntry& vp = entries[lo];
+  vp.hi          = hi;
+  if (hi - lo == 1)
+  {
+    vp.mu  = 0;
+    vp.mid = hi;
+    return;
+  }
+
+  size_t mid = lo + 1 + (hi - lo - 1) / 2;
+  std::nth_element(entries.begin() + lo + 1,
+                   entries.begin() + mid,
+                   entries.begin() + hi,
+                   [&vp](const IndexEntry& a, const IndexEntry& b) {
+                     return get_l1(a.co, vp.co) < get_l1(b.co, vp.co);
+                   });
+  vp.mu  = get_l1(entries[mid].co, vp.co);
+  vp.mid = mid;
+
+  build_vp_tree(entries, lo + 1, mid);
+  build_vp_tree(entries, mid, hi);
+}
+
+// A subtree (is_point false) with a lower bound on the distances within it,
+// or an entry (is_point true) with its distance.
+class Item
+{
+  public:
+  double bound;
+  size_t bucket;
+  size_t pos;
+  bool   is_point;
+  bool operator>(const Item& rhs) const { return bound > rhs.bound; }
+};
+
+// Best-first traversal of the vp-trees of all buckets with the same transposes as ck,
+// returning entries in increasing order of distance. The heap is reused between
+// searches on a thread, so searching does not allocate once warm.
+class Search
 {
-  size_t count = 0;
-  for (auto& key : kc.get_keys())
+  private:
+  const Index&       index;
+  const CacheKey&    ck;
+  bool               query_first;
+  std::vector<Item>& heap;
+
+  static std::vector<Item>& get_heap()
+  {
+    static thread_local std::vector<Item> heap;
+    return heap;
+  }
+
+  void push(const Item& item)
+  {
+    heap.push_back(item);
+    std::push_heap(heap.begin(), heap.end(), std::greater<Item>());
+  }
+
+  public:
+  // query_first : distances are ck.get_distance(key), otherwise key.get_distance(ck)
+  Search(const Index& index_, const CacheKey& ck_, bool query_first_)
+    : index(index_), ck(ck_), query_first(query_first_), heap(get_heap())
   {
-    if (graph.contains(kc.at(key)) && key.get_distance(ck) < threshold &&
-        Derivabilty(kc.at(key), ck.gg).is_derivable)
+    heap.clear();
+    for (size_t bi = 0; bi < index.buckets.size(); ++bi)
     {
-      ++count;
-      if (count > rank)
+      if (index.buckets[bi].gg->same_transposes(ck.gg) && !index.buckets[bi].entries.empty())
       {
-        return true;
+        push({-ws_slack, bi, 0, false});
       }
     }
   }
-  return false;
+
+  // lower bound on the distance of all entries not yet returned
+  double get_bound() const
+  {
+    return heap.empty() ? std::numeric_limits<double>::max() : heap.front().bound;
+  }
+
+  // nullptr when there are no more entries
+  const IndexEntry* next(double& distance)
+  {
+    while (!heap.empty())
+    {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<Item>());
+      Item item = heap.back();
+      heap.pop_back();
+
+      const IndexEntry& x = index.buckets[item.bucket].entries[item.pos];
+      if (item.is_point)
+      {
+        distance = item.bound;
+        return &x;
+      }
+
+      double d_vp = get_l1(ck.gg.get_metric_co(), x.co);
+      push({query_first ? ck.get_distance(*x.ck) : x.ck->get_distance(ck),
+            item.bucket,
+            item.pos,
+            true});
+      if (item.pos + 1 < x.mid)
+      {
+        push({std::max(item.bound, d_vp - x.mu - ws_slack), item.bucket, item.pos + 1, false});
+      }
+      if (x.mid < x.hi)
+      {
+        push({std::max(item.bound, x.mu - d_vp - ws_slack), item.bucket, x.mid, false});
+      }
+    }
+    return nullptr;
+  }
+};
+
+bool is_valid(const IndexEntry& x, const CacheKey& ck, const Graph& graph)
+{
+  return graph.contains(*x.hp) && Derivabilty(*x.hp, ck.gg).is_derivable;
+}
 }
 
-// rank = 0 for nearest, 1 for second nearest etc.
-CacheKey get(const CacheKey& ck, const Graph& graph, const KernelCache& kc, size_t rank)
+Index::Index(const CacheMap& vals)
 {
-  if (!is_within(ck, graph, kc, std::numeric_limits<double>::max(), rank))
+  for (auto& x : vals)
   {
-    throw miog_error("In get, with none within radius <double>::max.");
+    const CacheKey& key = x.first;
+    auto            bucket =
+      std::find_if(buckets.begin(), buckets.end(), [&key](const IndexBucket& b) {
+        return b.dvc == key.dvc && b.gg->same_transposes(key.gg) &&
+               b.gg->floattype == key.gg.floattype;
+      });
+    if (bucket == buckets.end())
+    {
+      buckets.push_back({&key.gg, key.dvc, {}});
+      bucket = buckets.end() - 1;
+    }
+    bucket->entries.push_back({&key, &x.second, key.gg.get_metric_co(), 0, 0, 0});
   }
 
-  auto cache_keys = kc.get_keys();
-  if (cache_keys.size() == 0)
+  for (auto& bucket : buckets)
   {
-    throw miog_error("No cache keys. Possibly not included in kernelcache.cpp, very strange");
+    build_vp_tree(bucket.entries, 0, bucket.entries.size());
   }
+}
 
-  using dst_tup = std::tuple<double, size_t>;
-  std::vector<dst_tup> v_di;
+bool is_within(
+  const CacheKey& ck, const Graph& graph, const KernelCache& kc, double threshold, size_t rank)
+{
+  auto   index = kc.get_index();
+  Search search(*index, ck, false);
 
-  for (size_t keyi = 0; keyi < cache_keys.size(); ++keyi)
+  size_t            count = 0;
+  double            distance;
+  const IndexEntry* x;
+  while (search.get_bound() < threshold && (x = search.next(distance)) != nullptr)
   {
-    auto key      = cache_keys[keyi];
-    auto distance = ck.get_distance(key);
-    auto hp       = kc.at(key);
-    if (graph.contains(kc.at(key)) && Derivabilty(hp, ck.gg).is_derivable)
+    if (distance < threshold && is_valid(*x, ck, graph))
     {
-      v_di.emplace_back(std::make_tuple(distance, keyi));
+      ++count;
+      if (count > rank)
+      {
+        return true;
+      }
     }
   }
+  return false;
+}
 
-  if (rank >= v_di.size())
+// rank = 0 for nearest, 1 for second nearest etc.
+CacheKey get(const CacheKey& ck, const Graph& graph, const KernelCache& kc, size_t rank)
+{
+  // exact match fast path
+  if (rank == 0 && kc.contains(ck) && graph.contains(kc.at(ck)) &&
+      Derivabilty(kc.at(ck), ck.gg).is_derivable)
   {
-    throw miog_error("rank too large in get, too few candidates. Use is_within to check");
+    return ck;
   }
 
-  std::nth_element(
-    v_di.begin(), v_di.begin() + rank, v_di.end(), [](const dst_tup& a, const dst_tup& b) {
-      return std::get<0>(a) < std::get<0>(b);
-    });
+  auto   index = kc.get_index();
+  Search search(*index, ck, true);
 
-  auto nearest_derivable = cache_keys[std::get<1>(v_di[rank])];
-
-  // confirm derivability
-  Derivabilty drvble(kc.at(nearest_derivable), ck.gg);
-  if (!drvble.is_derivable)
+  size_t            count = 0;
+  double            distance;
+  const IndexEntry* x;
+  while ((x = search.next(distance)) != nullptr)
   {
-    throw miog_error("internal logic error : nearest is not derivable. msg : " + drvble.msg);
+    if (is_valid(*x, ck, graph))
+    {
+      if (count == rank)
+      {
+        return *x->ck;
+      }
+      ++count;
+    }
   }
 
-  return nearest_derivable;
+  throw miog_error("rank too large in get, too few candidates. Use is_within to check");
 }
 }
 }
@@ -34,15 +34,14 @@ class NormalFormGenerator : public prepgen::PrepGenerator
     return dp.cw2_n_macro_tiles_pll_unroll * dp.at(emat_x).n_groups;
   }
 
-  void append_copy_string(std::stringstream& ss)
+  void append_copy_string(emit::Emitter& ss)
   {
     ss << "w[mu_pll_i*WRITE_STRIDE_PLL_K + mu_perp_i*WRITE_STRIDE_PERP_K] = " << mchar
        << "[mu_pll_i*READ_STRIDE_PLL_K + mu_perp_i*READ_STRIDE_PERP_K];";
   }
 
-  KernBlob get_kernelstring() override final
+  void append_kernelstring(emit::Emitter& ss) override final
   {
-    std::stringstream ss;
 
     ss << "#define TFLOAT " << dp.t_float << '\n'
        << "#define TINT" << Mem::M().name[emat_x] << " " << dp.tints[emat_x] << '\n'
@@ -77,15 +76,12 @@ class NormalFormGenerator : public prepgen::PrepGenerator
     final_unroll_depth =
       (final_unroll_depth == 0 ? hp.sus[Mat::E::C].vs[NonChi::E::UNR] : final_unroll_depth);
 
-    ss << "\n#define FINAL_UNROLL_DEPTH " << final_unroll_depth << "\n\n\n"
-       << "__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))" << '\n'
-       << "__kernel void " << kernelname;
-
-    append_fargs(ss);
+    ss << "\n#define FINAL_UNROLL_DEPTH " << final_unroll_depth << "\n\n\n";
+    append_declaration(ss);
 
     ss << "{"
        << "\n/* setting up where this thread works */\n"
-       << "TINT" << Mem::M().name[emat_x] << " group_id = get_group_id(0);\n"
+       << "TINT" << Mem::M().name[emat_x] << " group_id = " << get_group_id_string() << ";\n"
        << "TINT" << Mem::M().name[emat_x] << " micro_id = (TINT" << Mem::M().name[emat_x]
        << ")(get_local_id(0));\n"
        << "\n"
@@ -151,13 +147,6 @@ for (ushort mu_perp_i = 0; mu_perp_i < MICRO_TILE_PERP_UNROLL; ++mu_perp_i) {
 )";
 
     ss << "\n}\n";
-
-    return {get_ktype(),
-            {u_a, u_b, u_c, u_w, u_alpha, u_beta},
-            ss.str(),
-            kernelname,
-            get_global_work_size(),
-            get_local_work_size()};
   }
 
   virtual void setup_final() override final {}
@@ -175,10 +164,17 @@ for (ushort mu_perp_i = 0; mu_perp_i < MICRO_TILE_PERP_UNROLL; ++mu_perp_i) {
   }
 };
 
-KernBlob
-get_nform_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+KernBlob get_nform_kernelstring(Mat::E               emat_x,
+                                const HyPas&         hp,
+                                const Geometry&      gg,
+                                const DerivedParams& dp,
+                                bool                 as_fused_function)
 {
   NormalFormGenerator nfg(emat_x, hp, gg, dp);
+  if (as_fused_function)
+  {
+    nfg.set_as_fused_function();
+  }
   nfg.setup();
   return nfg.get_kernelstring();
 }
@@ -47,7 +47,7 @@ void PrepGenerator::set_usage()
   }
 }
 
-void PrepGenerator::append_basic_what_definitions(std::stringstream& ss)
+void PrepGenerator::append_basic_what_definitions(emit::Emitter& ss)
 {
   ss << "#define TFLOAT  " << dp.t_float << "\n"
      << "#define LD" << MCHAR << " " << gg.ldX.at(emat_x) << "\n"
@@ -59,6 +59,26 @@ void PrepGenerator::append_basic_what_definitions(std::stringstream& ss)
      << "#define DIM_UNCOAL " << gg.get_uncoal(emat_x) << "\n\n";
 }
 
+void PrepGenerator::append_declaration(emit::Emitter& ss)
+{
+  if (as_fused_function)
+  {
+    ss << "void " << kernelname;
+    append_fargs(ss, "\nconst uint fused_group_id");
+  }
+  else
+  {
+    ss << "__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))" << '\n'
+       << "__kernel void " << kernelname;
+    append_fargs(ss);
+  }
+}
+
+std::string PrepGenerator::get_group_id_string()
+{
+  return as_fused_function ? "fused_group_id" : "get_group_id(0)";
+}
+
 PrepGenerator::PrepGenerator(Mat::E               emat_x_,
                              const HyPas&         hp_,
                              const Geometry&      gg_,
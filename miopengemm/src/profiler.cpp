@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <miopengemm/profiler.hpp>
+
+namespace MIOpenGEMM
+{
+namespace profiler
+{
+
+void Histogram::add(double t)
+{
+  double x = t < 1 ? 0 : std::log2(t) * buckets_per_octave;
+  size_t b = std::min<size_t>(n_buckets - 1, static_cast<size_t>(x));
+  ++counts[b];
+  ++n;
+  total += t;
+  min = std::min(min, t);
+  max = std::max(max, t);
+}
+
+double Histogram::get_edge(size_t b)
+{
+  return std::exp2(static_cast<double>(b) / buckets_per_octave);
+}
+
+double Histogram::get_mean() const { return n == 0 ? 0 : total / n; }
+
+double Histogram::get_percentile(double p) const
+{
+  if (n == 0)
+  {
+    return 0;
+  }
+  size_t rank = static_cast<size_t>(std::ceil(p * n));
+  size_t seen = 0;
+  size_t b    = 0;
+  for (; b < n_buckets - 1; ++b)
+  {
+    seen += counts[b];
+    if (seen >= std::max<size_t>(rank, 1))
+    {
+      break;
+    }
+  }
+  // the geometric centre of the bucket
+  double t = std::sqrt(get_edge(b) * get_edge(b + 1));
+  return std::min(max, std::max(min, t));
+}
+
+double Profile::get_total() const
+{
+  double total = 0;
+  for (auto& histogram : histograms)
+  {
+    total += histogram.total;
+  }
+  return total;
+}
+
+namespace
+{
+
+class State
+{
+  public:
+  std::atomic<size_t> sampling;
+  std::atomic<size_t> n_calls{0};
+
+  std::atomic<size_t> n_pending{0};
+  std::atomic<size_t> n_unavailable{0};
+  std::atomic<size_t> n_failed{0};
+
+  std::mutex             mutex;
+  std::map<int, Profile> profiles;
+
+  State()
+  {
+    const char* x = std::getenv("MIOPENGEMM_PROFILE");
+    sampling      = x == nullptr ? 0 : std::strtoul(x, nullptr, 10);
+  }
+};
+
+State& get_state()
+{
+  static State state;
+  return state;
+}
+
+void add_time(int ID, KType::E ktype, double t)
+{
+  auto&                       state = get_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.profiles[ID].histograms[ktype].add(t);
+}
+
+// (ID, ktype) is passed to the callback in user_data, so that nothing is allocated
+void* encode(int ID, KType::E ktype)
+{
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(ID) * KType::E::N + ktype);
+}
+
+void CL_CALLBACK on_complete(cl_event event, cl_int status, void* user_data)
+{
+  auto&    state = get_state();
+  auto     x     = reinterpret_cast<uintptr_t>(user_data);
+  int      ID    = static_cast<int>(x / KType::E::N);
+  KType::E ktype = static_cast<KType::E>(x % KType::E::N);
+
+  // called on a thread of the OpenCL runtime : nothing here may block or throw
+  if (status < 0)
+  {
+    ++state.n_failed;
+  }
+  else
+  {
+    cl_ulong t_start = 0;
+    cl_ulong t_end   = 0;
+    if (clGetEventProfilingInfo(
+          event, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &t_start, nullptr) != CL_SUCCESS ||
+        clGetEventProfilingInfo(
+          event, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &t_end, nullptr) != CL_SUCCESS)
+    {
+      ++state.n_unavailable;
+    }
+    else
+    {
+      add_time(ID, ktype, 1e-3 * (t_end - t_start));
+    }
+  }
+  clReleaseEvent(event);
+  --state.n_pending;
+}
+}
+
+void set_sampling(size_t n) { get_state().sampling = n; }
+
+size_t get_sampling() { return get_state().sampling; }
+
+bool sample()
+{
+  auto&  state = get_state();
+  size_t n     = state.sampling.load(std::memory_order_relaxed);
+  return n != 0 && state.n_calls.fetch_add(1, std::memory_order_relaxed) % n == 0;
+}
+
+void add_call(int ID, const std::string& geometry)
+{
+  auto&                       state = get_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  Profile&                    profile = state.profiles[ID];
+  profile.geometry                    = geometry;
+  ++profile.n_calls;
+}
+
+void record(int ID, KType::E ktype, cl_event event)
+{
+  auto& state = get_state();
+  if (clRetainEvent(event) != CL_SUCCESS)
+  {
+    ++state.n_failed;
+    return;
+  }
+  ++state.n_pending;
+  if (clSetEventCallback(event, CL_COMPLETE, &on_complete, encode(ID, ktype)) != CL_SUCCESS)
+  {
+    clReleaseEvent(event);
+    --state.n_pending;
+    ++state.n_failed;
+  }
+}
+
+void record_time(int ID, KType::E ktype, double t) { add_time(ID, ktype, t); }
+
+std::map<int, Profile> get_profiles()
+{
+  auto&                       state = get_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.profiles;
+}
+
+Counts get_counts()
+{
+  auto& state = get_state();
+  return {state.n_pending, state.n_unavailable, state.n_failed};
+}
+
+void reset()
+{
+  auto&                       state = get_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.profiles.clear();
+  state.n_unavailable = 0;
+  state.n_failed      = 0;
+}
+
+std::string get_report()
+{
+  auto profiles = get_profiles();
+  auto counts   = get_counts();
+
+  std::vector<std::pair<int, const Profile*>> order;
+  double                                      total = 0;
+  for (auto& x : profiles)
+  {
+    order.emplace_back(x.first, &x.second);
+    total += x.second.get_total();
+  }
+  std::sort(order.begin(), order.end(), [](const std::pair<int, const Profile*>& a,
+                                           const std::pair<int, const Profile*>& b) {
+    return a.second->get_total() > b.second->get_total();
+  });
+
+  std::stringstream ss;
+  ss << "sampling one in " << get_sampling() << " calls. events pending : " << counts.n_pending
+     << ", unavailable : " << counts.n_unavailable << ", failed : " << counts.n_failed << '\n';
+  for (auto& x : order)
+  {
+    const Profile& profile = *x.second;
+    double         share   = total == 0 ? 0 : 100 * profile.get_total() / total;
+    ss << "\nID " << x.first << "  " << profile.geometry << '\n'
+       << std::fixed << std::setprecision(1) << "share of time " << share << "%, sampled calls "
+       << profile.n_calls << ", total time " << profile.get_total() << " [us]\n"
+       << std::setw(10) << "kernel" << std::setw(8) << "n" << std::setw(11) << "mean"
+       << std::setw(11) << "p50" << std::setw(11) << "p90" << std::setw(11) << "p99"
+       << std::setw(11) << "max" << '\n';
+    for (size_t kt = 0; kt < KType::E::N; ++kt)
+    {
+      const Histogram& h = profile.histograms[kt];
+      if (h.n != 0)
+      {
+        ss << std::setw(10) << KType::M().name[kt] << std::setw(8) << h.n << std::setw(11)
+           << h.get_mean() << std::setw(11) << h.get_percentile(0.5) << std::setw(11)
+           << h.get_percentile(0.9) << std::setw(11) << h.get_percentile(0.99) << std::setw(11)
+           << h.max << '\n';
+      }
+    }
+  }
+  return ss.str();
+}
+}
+}
@@ -93,15 +93,23 @@ int ProgramCacher::get_ID(bool              isColMajor,
   int               ID = -1;
   std::stringstream ss;
 
-  // get device id from ptr_queue.
-  cl_device_id device_id;
-  clGetCommandQueueInfo(*ptr_queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &device_id, nullptr);
-
-  // Getting device name.
-  size_t      info_size(0);
-  std::string info_st(400, ' ');
-  clGetDeviceInfo(device_id, CL_DEVICE_NAME, info_st.size(), &info_st[0], &info_size);
-  std::string device_name = info_st.substr(0, info_size - 1);
+  cl_device_id device_id = nullptr;
+  std::string  device_name;
+  if (simdev != nullptr)
+  {
+    device_name = simdev->devinfo.device_name;
+  }
+  else
+  {
+    // get device id from ptr_queue.
+    clGetCommandQueueInfo(*ptr_queue, CL_QUEUE_DEVICE, sizeof(cl_device_id), &device_id, nullptr);
+
+    // Getting device name.
+    size_t      info_size(0);
+    std::string info_st(400, ' ');
+    clGetDeviceInfo(device_id, CL_DEVICE_NAME, info_st.size(), &info_st[0], &info_size);
+    device_name = info_st.substr(0, info_size - 1);
+  }
 
   ss << isColMajor << tA << tB << tC << '.' << m << '.' << n << '.' << k << '.' << lda << '.' << ldb
      << '.' << ldc << '.' << w_size << '.' << beta_type << '.' << floattype << '.' << device_name;
@@ -117,16 +125,20 @@ int ProgramCacher::get_ID(bool              isColMajor,
   {
 
     owrite::Writer silent_mowri(Ver::E::SILENT, "");
-    cl_context     context;
-    oclutil::cl_set_command_queue_info(
-      *ptr_queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &context, nullptr, "GEMM", true);
+    cl_context     context = nullptr;
+    if (simdev == nullptr)
+    {
+      oclutil::cl_set_command_queue_info(
+        *ptr_queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &context, nullptr, "GEMM", true);
+    }
 
     size_t      rank = 0;
     Constraints constraints("");
     Geometry    gg(isColMajor, tA, tB, tC, lda, ldb, ldc, m, n, k, w_size, floattype);
 
-    oclutil::DevInfo devinfo(*ptr_queue);
-    auto             soln =
+    oclutil::DevInfo devinfo =
+      simdev != nullptr ? simdev->devinfo : oclutil::DevInfo(*ptr_queue);
+    auto soln =
       get_default_soln(devinfo, gg, constraints, silent_mowri, IfNoCache::E::GENERIC, rank);
 
     std::vector<KernBlob> v_blobs;
@@ -153,13 +165,30 @@ int ProgramCacher::get_ID(bool              isColMajor,
       throw miog_error(errm.str());
     }
 
-    program_cache[ID] = Programs(device_id, context, silent_mowri);
+    program_cache[ID] = simdev != nullptr ? Programs(simdev, silent_mowri)
+                                          : Programs(device_id, context, silent_mowri);
     hyper_params[ID]  = soln.hypas;
 
     IDs[key] = ID;
 
     lock.unlock();
-    program_cache[ID].update(v_blobs);
+    if (simdev != nullptr && soln.is_tiny)
+    {
+      // the Bundle of the (untuned) hypas is not what runs
+      program_cache[ID].update(v_blobs);
+      program_cache[ID].sim_times[KType::E::MAIN] = simdev->get_tiny_time(gg);
+    }
+    else if (simdev != nullptr)
+    {
+      // the modelled times of the kernels are computed from a Bundle
+      kerngen::Bundle bundle(soln.hypas, gg);
+      bundle.v_tgks = v_blobs;
+      program_cache[ID].update(bundle);
+    }
+    else
+    {
+      program_cache[ID].update(v_blobs);
+    }
   }
 
   return ID;
@@ -5,9 +5,11 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 #include <miopengemm/bundle.hpp>
 #include <miopengemm/error.hpp>
 #include <miopengemm/oclutil.hpp>
+#include <miopengemm/profiler.hpp>
 #include <miopengemm/programs.hpp>
 
 namespace MIOpenGEMM
@@ -32,26 +34,42 @@ Program::update(const KernBlob& ks, owrite::Writer& mowri, const std::string& bu
 
   else
   {
-    if (sclp->clprog != nullptr)
-    {
-      oclutil::cl_release_program(sclp->clprog, "update", true);
-    }
-
     kblob = ks;
     mowri << "compiling " << KType::M().name[kblob.e_ktype] << ". " << Flush;
-    auto start = std::chrono::high_resolution_clock::now();
-    oclr       = oclutil::cl_set_program(
-      context, device_id, kblob.kernstr, sclp->clprog, build_opts, mowri, false);
+    auto start    = std::chrono::high_resolution_clock::now();
+    bool compiled = false;
+    oclr          = programstore::get_program_store().get(
+      context, device_id, kblob.kernstr, build_opts, mowri, sclp, compiled);
 
     auto                          end   = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> fp_ms = end - start;
     double                        secs  = fp_ms.count();
-    std::string                   pre   = oclr.fail() ? "Failed in " : "Done in ";
+    std::string pre = oclr.fail() ? "Failed in " : (compiled ? "Done in " : "Shared, done in ");
     mowri << pre << std::setprecision(3) << secs << std::setprecision(6) << " [s]" << Endl;
   }
   return oclr;
 }
 
+oclutil::Result
+Program::update_simulated(const KernBlob& ks, owrite::Writer& mowri, double compile_delay)
+{
+  // no update needed
+  if (kblob.kernstr != "" && ks.kernstr == kblob.kernstr)
+  {
+    return {};
+  }
+
+  kblob = ks;
+  mowri << "compiling " << KType::M().name[kblob.e_ktype] << " (simulated). " << Flush;
+  auto start = std::chrono::high_resolution_clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(compile_delay));
+  auto                          end   = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> fp_ms = end - start;
+  mowri << "Done in " << std::setprecision(3) << fp_ms.count() << std::setprecision(6) << " [s]"
+        << Endl;
+  return {};
+}
+
 void KernelTime::update_times(const cl_event& event)
 {
 
@@ -89,6 +107,12 @@ Programs::Programs(const cl_device_id& id, const cl_context& ctxt, owrite::Write
   }
 }
 
+Programs::Programs(std::shared_ptr<simdevice::Device> simdev_, owrite::Writer& mowri_)
+  : act_inds(0), v_wait_indices(0), ptr_mowri(&mowri_), simdev(simdev_)
+{
+  sim_times.fill(-1.);
+}
+
 oclutil::Result Programs::update(const std::vector<KernBlob>& kbs)
 {
 
@@ -109,9 +133,17 @@ oclutil::Result Programs::update(const std::vector<KernBlob>& kbs)
 
   v_wait_indices = kerngen::get_v_wait_indices(kbs, *ptr_mowri);
   act_inds.resize(0);
+  sim_times.fill(-1.);
   for (size_t kbi = 0; kbi < kbs.size(); ++kbi)
   {
-    auto x = programs.at(kbs[kbi].e_ktype).update(kbs[kbi], *ptr_mowri, build_options);
+    trace::Scope scope(tracer.get(),
+                       "compile " + KType::M().name[kbs[kbi].e_ktype],
+                       "compile",
+                       {{"kernel", kbs[kbi].fname}});
+    auto x = is_simulated()
+               ? programs.at(kbs[kbi].e_ktype)
+                   .update_simulated(kbs[kbi], *ptr_mowri, simdev->params.compile_delay)
+               : programs.at(kbs[kbi].e_ktype).update(kbs[kbi], *ptr_mowri, build_options);
 
     if (x.fail())
     {
@@ -125,15 +157,77 @@ oclutil::Result Programs::update(const std::vector<KernBlob>& kbs)
   return {};
 }
 
+oclutil::Result Programs::update(const kerngen::Bundle& bundle)
+{
+  auto oclr = update(bundle.v_tgks);
+  if (is_simulated())
+  {
+    sim_times = simdev->get_modelled_times(bundle);
+  }
+  return oclr;
+}
+
+oclutil::Result Programs::run_simulated(KernelTimes* ptr_ktimes, int profile_ID) const
+{
+  // kernels run in series on the simulated device's clock
+  size_t minstart = simdev->get_clock();
+  double total    = 0;
+  for (auto& act_ind : act_inds)
+  {
+    if (sim_times[act_ind] < 0)
+    {
+      std::stringstream errm;
+      errm << "no modelled time for " << KType::M().name[act_ind]
+           << " in Programs::run_simulated. Simulated Programs should be updated from a Bundle.";
+      throw miog_error(errm.str());
+    }
+
+    double t = simdev->sample(sim_times[act_ind]);
+    total += t;
+    size_t t_start = simdev->get_clock();
+    size_t t_end   = simdev->advance(t);
+    if (ptr_ktimes != nullptr)
+    {
+      KernelTime& pt = ptr_ktimes->ktimes[act_ind];
+      pt.t_start     = t_start;
+      pt.t_end       = t_end;
+      pt.v_times.push_back(1e-6 * (t_end - t_start));
+    }
+    if (profile_ID >= 0)
+    {
+      profiler::record_time(profile_ID, static_cast<KType::E>(act_ind), 1e-3 * (t_end - t_start));
+    }
+  }
+
+  if (ptr_ktimes != nullptr)
+  {
+    ptr_ktimes->extime = 1e-6 * (simdev->get_clock() - minstart);
+  }
+
+  if (simdev->params.sleep_on_run)
+  {
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(total));
+  }
+
+  return {};
+}
+
 oclutil::Result Programs::run(const cl_command_queue& queue,
                               const AllKernArgs&      all_args,
                               cl_uint                 n_user_wait_list,
                               const cl_event*         user_wait_list,
                               KernelTimes*            ptr_ktimes,
                               cl_event*               ptr_user_event,
-                              bool                    debug_mode) const
+                              bool                    debug_mode,
+                              int                     profile_ID) const
 {
+  if (is_simulated())
+  {
+    return run_simulated(ptr_ktimes, profile_ID);
+  }
+
   const bool             ev_from_user = (ptr_user_event != nullptr);
+  const bool             profiled     = (profile_ID >= 0);
   auto                   n_active     = act_inds.size();
   std::vector<cl_kernel> clkerns(n_active);
 
@@ -170,7 +264,9 @@ oclutil::Result Programs::run(const cl_command_queue& queue,
     ptrs_events[i] = &events[i];
   }
 
-  ptrs_events.emplace_back(ptr_user_event);
+  // a profiled last kernel needs an event, even if the user did not ask for one
+  cl_event last_event = nullptr;
+  ptrs_events.emplace_back(ev_from_user || !profiled ? ptr_user_event : &last_event);
 
   for (int k_ind = 0; k_ind < n_active; ++k_ind)
   {
@@ -242,6 +338,19 @@ oclutil::Result Programs::run(const cl_command_queue& queue,
     ptr_ktimes->extime = (1e-6 * (maxend - minstart));
   }
 
+  if (profiled)
+  {
+    // the times are read when the kernels complete, without blocking here
+    for (int k_ind = 0; k_ind < n_active; ++k_ind)
+    {
+      profiler::record(profile_ID, static_cast<KType::E>(act_inds[k_ind]), *ptrs_events[k_ind]);
+    }
+    if (!ev_from_user)
+    {
+      clReleaseEvent(last_event);
+    }
+  }
+
   if (debug_mode)
   {
     for (int k_ind = 0; k_ind < n_active - 1; ++k_ind)
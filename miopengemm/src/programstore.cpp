@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <miopengemm/programstore.hpp>
+
+namespace MIOpenGEMM
+{
+namespace programstore
+{
+
+std::string get_normalized(const std::string& kernstr)
+{
+  std::string normalized;
+  normalized.reserve(kernstr.size());
+  // true at the start of a line, and while skipping its leading white space
+  bool line_start = true;
+  bool in_space   = false;
+  for (size_t i = 0; i < kernstr.size(); ++i)
+  {
+    char c = kernstr[i];
+    if (c == '/' && i + 1 < kernstr.size() && kernstr[i + 1] == '/')
+    {
+      i = kernstr.find('\n', i);
+      if (i == std::string::npos)
+      {
+        break;
+      }
+      c = '\n';
+    }
+    else if (c == '/' && i + 1 < kernstr.size() && kernstr[i + 1] == '*')
+    {
+      i = kernstr.find("*/", i + 2);
+      if (i == std::string::npos)
+      {
+        break;
+      }
+      ++i;
+      in_space = true;
+      continue;
+    }
+
+    if (c == '\n')
+    {
+      if (!line_start)
+      {
+        normalized.push_back('\n');
+      }
+      line_start = true;
+      in_space   = false;
+    }
+    else if (c == ' ' || c == '\t' || c == '\r')
+    {
+      in_space = true;
+    }
+    else
+    {
+      if (in_space && !line_start)
+      {
+        normalized.push_back(' ');
+      }
+      normalized.push_back(c);
+      line_start = false;
+      in_space   = false;
+    }
+  }
+  return normalized;
+}
+
+std::shared_ptr<SafeCLProgram> ProgramStore::find(size_t             hash,
+                                                  cl_context         context,
+                                                  cl_device_id       device_id,
+                                                  const std::string& build_options,
+                                                  const std::string& normalized)
+{
+  auto bucket = entries.find(hash);
+  if (bucket != entries.end())
+  {
+    for (auto& entry : bucket->second)
+    {
+      if (entry.context == context && entry.device_id == device_id &&
+          entry.build_options == build_options && entry.normalized == normalized)
+      {
+        auto sclp = entry.sclp.lock();
+        if (sclp)
+        {
+          return sclp;
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+
+void ProgramStore::erase_expired()
+{
+  for (auto bucket = entries.begin(); bucket != entries.end();)
+  {
+    auto& v = bucket->second;
+    v.erase(std::remove_if(v.begin(), v.end(), [](const Entry& x) { return x.sclp.expired(); }),
+            v.end());
+    bucket = v.empty() ? entries.erase(bucket) : std::next(bucket);
+  }
+}
+
+oclutil::Result ProgramStore::get(cl_context                      context,
+                                  cl_device_id                    device_id,
+                                  const std::string&              kernstr,
+                                  const std::string&              build_options,
+                                  owrite::Writer&                 mowri,
+                                  std::shared_ptr<SafeCLProgram>& sclp,
+                                  bool&                           compiled)
+{
+  std::string normalized = get_normalized(kernstr);
+  size_t      hash       = std::hash<std::string>()(normalized);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sclp = find(hash, context, device_id, build_options, normalized);
+    if (sclp)
+    {
+      ++n_shared;
+      compiled = false;
+      return {};
+    }
+  }
+
+  std::shared_ptr<SafeCLProgram> new_sclp(new SafeCLProgram);
+  auto oclr = oclutil::cl_set_program(
+    context, device_id, kernstr, new_sclp->clprog, build_options, mowri, false);
+  compiled = true;
+  sclp     = new_sclp;
+  if (oclr.fail())
+  {
+    return oclr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ++n_compiled;
+  // another thread may have compiled the same program in the meantime, theirs is kept
+  auto existing = find(hash, context, device_id, build_options, normalized);
+  if (existing)
+  {
+    sclp = existing;
+    return {};
+  }
+  // compiling is slow compared to sweeping the entries
+  erase_expired();
+  entries[hash].push_back({context, device_id, build_options, std::move(normalized), sclp});
+  return {};
+}
+
+Stats ProgramStore::get_stats()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t                      n_live = 0;
+  for (auto& bucket : entries)
+  {
+    for (auto& entry : bucket.second)
+    {
+      n_live += entry.sclp.expired() ? 0 : 1;
+    }
+  }
+  return {n_compiled, n_shared, n_live};
+}
+
+ProgramStore& get_program_store()
+{
+  static ProgramStore store;
+  return store;
+}
+}
+}
@@ -10,4 +10,10 @@ RandomUtil::RandomUtil() : rd(), gen(rd()) {}
 RandomUtil::RandomUtil(int seed) : rd(), gen(seed) {}
 
 size_t RandomUtil::get_from_range(size_t upper) { return unidis(gen) % upper; }
+
+void RandomUtil::seed(int seed)
+{
+  gen.seed(seed);
+  unidis.reset();
+}
 }
@@ -208,18 +208,21 @@ Geometry get_canonical(const Geometry& gg, bool& swap_ab)
   SimpleBundle sbb(gg.ldX[Mat::E::B], Mat::E::B);
   redirect_base(isColMajor, tA, tB, tC, m, n, sba, sbb);
   swap_ab = (sba.emat == Mat::E::B);
-  return {isColMajor,
-          tA,
-          tB,
-          tC,
-          sba.ldx,
-          sbb.ldx,
-          gg.ldX[Mat::E::C],
-          m,
-          n,
-          gg.k,
-          gg.wSpaceSize,
-          gg.floattype};
+  Geometry canonical(isColMajor,
+                     tA,
+                     tB,
+                     tC,
+                     sba.ldx,
+                     sbb.ldx,
+                     gg.ldX[Mat::E::C],
+                     m,
+                     n,
+                     gg.k,
+                     gg.wSpaceSize,
+                     gg.floattype);
+  // a geometry with a convolution is canonical (see check_conv_consistent)
+  canonical.conv = gg.conv;
+  return canonical;
 }
 
 Geometry get_canonical(const Geometry& gg)
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <miopengemm/error.hpp>
+#include <miopengemm/roofline.hpp>
+
+namespace MIOpenGEMM
+{
+namespace roofline
+{
+
+double Traffic::get_intensity() const
+{
+  return get_bytes() == 0 ? 0 : flops / get_bytes();
+}
+
+std::array<Traffic, KType::E::N> get_traffic(const kerngen::Bundle& bundle)
+{
+  const Geometry&      gg  = bundle.gg;
+  const DerivedParams& dp  = bundle.dp;
+  double               fsb = gg.derived.float_size_bytes;
+  double               m   = gg.m;
+  double               n   = gg.n;
+  double               k   = gg.k;
+
+  std::array<Traffic, KType::E::N> traffic;
+
+  // every (macro tile) column of work groups reads all of a, every row all of b
+  double padded_m = dp.at(Mat::E::A).n_groups * dp.at(Mat::E::A).macro_tile_length;
+  double padded_n = dp.at(Mat::E::B).n_groups * dp.at(Mat::E::B).macro_tile_length;
+
+  Traffic& main   = traffic[KType::E::MAIN];
+  main.flops      = 2. * m * n * k;
+  main.read_bytes =
+    fsb * k * (padded_m * dp.at(Mat::E::B).n_groups + padded_n * dp.at(Mat::E::A).n_groups);
+
+  // with split k and stream-K, C is incremented atomically : read and written on each pass
+  double ice = bundle.hp.sus[Mat::E::C].vs[NonChi::E::ICE];
+  if (dp.main_stream_k != 0)
+  {
+    double n_tiles = dp.at(Mat::E::A).n_groups * dp.at(Mat::E::B).n_groups;
+    double passes  = 1. + std::min<double>(dp.main_n_work_groups, n_tiles) / n_tiles;
+    main.read_bytes += passes * fsb * m * n;
+    main.write_bytes = passes * fsb * m * n;
+  }
+  else if (ice > 1)
+  {
+    main.read_bytes += ice * fsb * m * n;
+    main.write_bytes = ice * fsb * m * n;
+  }
+  else
+  {
+    main.read_bytes += dp.main_does_beta_c_inc != 0 ? fsb * m * n : 0.;
+    main.write_bytes = fsb * m * n;
+  }
+
+  // the preparation kernels which run, on their own or fused in PREP
+  std::array<Traffic, KType::E::N> prep;
+  prep[KType::E::WSA].read_bytes   = fsb * m * k;
+  prep[KType::E::WSB].read_bytes   = fsb * n * k;
+  prep[KType::E::BETAC].read_bytes = fsb * m * n;
+  std::array<bool, KType::E::N> runs;
+  runs.fill(false);
+  runs[KType::E::WSA]   = bundle.hp.sus[Mat::E::A].vs[Chi::E::WOS] != Scratch::E::UNUSED;
+  runs[KType::E::WSB]   = bundle.hp.sus[Mat::E::B].vs[Chi::E::WOS] != Scratch::E::UNUSED;
+  runs[KType::E::BETAC] = dp.main_does_beta_c_inc == 0;
+
+  auto is_in_bundle = [&bundle](KType::E ktype) {
+    return std::any_of(bundle.v_tgks.begin(), bundle.v_tgks.end(), [ktype](const KernBlob& x) {
+      return x.e_ktype == ktype;
+    });
+  };
+
+  for (auto ktype : {KType::E::WSA, KType::E::WSB, KType::E::BETAC})
+  {
+    prep[ktype].write_bytes = prep[ktype].read_bytes;
+    if (runs[ktype] && is_in_bundle(ktype))
+    {
+      traffic[ktype] = prep[ktype];
+    }
+    else if (runs[ktype] && is_in_bundle(KType::E::PREP))
+    {
+      traffic[KType::E::PREP].read_bytes += prep[ktype].read_bytes;
+      traffic[KType::E::PREP].write_bytes += prep[ktype].write_bytes;
+    }
+  }
+  return traffic;
+}
+
+double Peaks::get_ridge() const { return bandwidth == 0 ? 0 : gflops / bandwidth; }
+
+namespace
+{
+
+class KnownDevice
+{
+  public:
+  std::string name;
+  // [GB/s]
+  double bandwidth;
+  // double precision throughput over single precision
+  double fp64_ratio;
+};
+
+// the fastest product with each name
+const std::vector<KnownDevice>& get_known_devices()
+{
+  static const std::vector<KnownDevice> known = {{"gfx906", 1024., 1. / 2.},
+                                                 {"gfx900", 484., 1. / 16.},
+                                                 {"Vega", 484., 1. / 16.},
+                                                 {"gfx803", 512., 1. / 16.},
+                                                 {"Fiji", 512., 1. / 16.},
+                                                 {"Ellesmere", 256., 1. / 16.},
+                                                 {"Hawaii", 320., 1. / 2.}};
+  return known;
+}
+
+// 0 if the environment variable is not set
+double get_env_double(const char* name)
+{
+  const char* x = std::getenv(name);
+  return x != nullptr && *x != '\0' ? std::strtod(x, nullptr) : 0.;
+}
+}
+
+Peaks get_peaks(const oclutil::DevInfo& devinfo, char floattype)
+{
+  const KnownDevice* known = nullptr;
+  for (auto& x : get_known_devices())
+  {
+    if (devinfo.device_name.find(x.name) != std::string::npos)
+    {
+      known = &x;
+      break;
+    }
+  }
+
+  Peaks peaks;
+  peaks.gflops =
+    2. * 64. * devinfo.device_max_compute_units * devinfo.device_max_clock_frequency / 1e3;
+  if (floattype == 'd')
+  {
+    double fp64_ratio = get_env_double("MIOPENGEMM_FP64_RATIO");
+    if (fp64_ratio == 0 && known != nullptr)
+    {
+      fp64_ratio = known->fp64_ratio;
+    }
+    peaks.gflops *= fp64_ratio;
+  }
+
+  peaks.bandwidth = get_env_double("MIOPENGEMM_BANDWIDTH");
+  if (peaks.bandwidth == 0 && known != nullptr)
+  {
+    peaks.bandwidth = known->bandwidth;
+  }
+  return peaks;
+}
+
+double measure_bandwidth(cl_command_queue command_queue,
+                         size_t           n_bytes,
+                         size_t           n_runs,
+                         owrite::Writer&  mowri)
+{
+  const std::string hash = "in measure_bandwidth";
+  oclutil::SafeClMem src(hash);
+  oclutil::SafeClMem dst(hash);
+  oclutil::cl_set_buffer_from_command_queue(
+    src.clmem, command_queue, CL_MEM_READ_WRITE, n_bytes, nullptr, hash, true);
+  oclutil::cl_set_buffer_from_command_queue(
+    dst.clmem, command_queue, CL_MEM_READ_WRITE, n_bytes, nullptr, hash, true);
+
+  double best = 0;
+  // the first copy is a warm up
+  for (size_t run = 0; run <= n_runs; ++run)
+  {
+    oclutil::SafeClEvent event(hash);
+    oclutil::cl_enqueue_copy_buffer(
+      command_queue, src.clmem, dst.clmem, 0, 0, n_bytes, 0, nullptr, &event.clevent, hash, true);
+    oclutil::cl_wait_for_events(1, &event.clevent, hash, true);
+
+    cl_ulong t_start = 0;
+    cl_ulong t_end   = 0;
+    oclutil::cl_set_event_profiling_info(
+      event.clevent, CL_PROFILING_COMMAND_START, sizeof(cl_ulong), &t_start, nullptr, hash, true);
+    oclutil::cl_set_event_profiling_info(
+      event.clevent, CL_PROFILING_COMMAND_END, sizeof(cl_ulong), &t_end, nullptr, hash, true);
+    if (run > 0 && t_end > t_start)
+    {
+      // bytes per ns : GB/s, reading and writing n_bytes
+      best = std::max(best, 2. * n_bytes / (t_end - t_start));
+    }
+  }
+
+  mowri << "copy of " << n_bytes / 1e6 << " MB, best of " << n_runs << " : " << best << " GB/s"
+        << Endl;
+  return best;
+}
+
+double Point::get_gflops() const { return traffic.flops / (1e6 * time); }
+
+double Point::get_bandwidth() const { return traffic.get_bytes() / (1e6 * time); }
+
+double Point::get_fraction_of_roofline(const Peaks& peaks) const
+{
+  double compute_time = peaks.gflops == 0 ? 0 : traffic.flops / (1e6 * peaks.gflops);
+  double memory_time  = peaks.bandwidth == 0 ? 0 : traffic.get_bytes() / (1e6 * peaks.bandwidth);
+  return std::max(compute_time, memory_time) / time;
+}
+
+bool Point::is_memory_bound(const Peaks& peaks) const
+{
+  return peaks.bandwidth != 0 && (peaks.gflops == 0 || traffic.get_bytes() / peaks.bandwidth >
+                                                         traffic.flops / peaks.gflops);
+}
+
+std::string get_string(const std::vector<Point>& points, const Peaks& peaks)
+{
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(1) << "roofline : ";
+  if (peaks.gflops == 0)
+  {
+    ss << "unknown peak gflops (set MIOPENGEMM_FP64_RATIO), ";
+  }
+  else
+  {
+    ss << "peak " << peaks.gflops << " gflops, ";
+  }
+  if (peaks.bandwidth == 0)
+  {
+    ss << "unknown bandwidth (set MIOPENGEMM_BANDWIDTH [GB/s], see roofline::measure_bandwidth)";
+  }
+  else
+  {
+    ss << peaks.bandwidth << " GB/s";
+    if (peaks.gflops != 0)
+    {
+      ss << ", ridge " << std::setprecision(2) << peaks.get_ridge() << " flops/byte";
+    }
+  }
+  ss << '\n'
+     << std::setw(8) << "kernel" << std::setw(11) << "time[ms]" << std::setw(12) << "flops/byte"
+     << std::setw(10) << "gflops" << std::setw(9) << "GB/s" << std::setw(10) << "%roof"
+     << std::setw(9) << "bound" << '\n';
+
+  for (auto& point : points)
+  {
+    // without the bandwidth (or the peak gflops, for a kernel with flops) neither is known
+    bool        known = peaks.bandwidth != 0 && (peaks.gflops != 0 || point.traffic.flops == 0);
+    std::string bound = !known ? "?" : point.is_memory_bound(peaks) ? "memory" : "compute";
+    ss << std::setw(8) << KType::M().name[point.ktype] << std::setprecision(4) << std::setw(11)
+       << point.time << std::setprecision(2) << std::setw(12) << point.traffic.get_intensity()
+       << std::setprecision(1) << std::setw(10) << point.get_gflops() << std::setw(9)
+       << point.get_bandwidth() << std::setw(10);
+    if (known)
+    {
+      ss << 100 * point.get_fraction_of_roofline(peaks);
+    }
+    else
+    {
+      ss << "?";
+    }
+    ss << std::setw(9) << bound << '\n';
+  }
+  return ss.str();
+}
+}
+}
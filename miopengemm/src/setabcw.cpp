@@ -1,6 +1,9 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <sstream>
@@ -63,6 +66,102 @@ void fill_uni(std::vector<TFloat>& v, size_t r_small, size_t r_big)
   }
 }
 
+namespace
+{
+// the finaliser of MurmurHash3, so that consecutive indices give uncorrelated values
+uint64_t get_mixed(uint64_t x)
+{
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+}
+
+template <typename TFloat>
+void fill_chunk(TFloat* chunk, size_t first, size_t n_elements, size_t seed)
+{
+  // values as in fill_uni, in [-1, 1) with 3 decimal places
+  auto fill = [chunk, first, seed](size_t i0, size_t i1) {
+    uint64_t seed_offset = static_cast<uint64_t>(seed) * 0x9e3779b97f4a7c15ULL;
+    for (size_t i = i0; i < i1; ++i)
+    {
+      chunk[i] = TFloat(-1) + (get_mixed(seed_offset + first + i) % 2000) / TFloat(1000);
+    }
+  };
+
+  // below this, starting threads costs more than it saves
+  const size_t min_per_thread = 1 << 16;
+  size_t       n_threads      = std::max<size_t>(1, std::thread::hardware_concurrency());
+  n_threads = std::max<size_t>(1, std::min(n_threads, n_elements / min_per_thread));
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < n_threads; ++t)
+  {
+    threads.emplace_back(fill, (t * n_elements) / n_threads, ((t + 1) * n_elements) / n_threads);
+  }
+  fill(0, n_elements / n_threads);
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+}
+
+template <typename TFloat>
+void set_device_buffer(cl_command_queue command_queue,
+                       cl_mem           buffer,
+                       size_t           n_elements,
+                       size_t           seed,
+                       size_t           chunk_elements)
+{
+  if (chunk_elements == 0)
+  {
+    throw miog_error("chunk_elements should be positive in set_device_buffer");
+  }
+
+  std::array<std::vector<TFloat>, 2> chunks;
+  std::array<cl_event, 2>            writes;
+  std::array<bool, 2>                in_flight{{false, false}};
+
+  auto wait = [&writes, &in_flight](size_t ci) {
+    if (in_flight[ci])
+    {
+      oclutil::cl_wait_for_events(1, &writes[ci], "in set_device_buffer", true);
+      oclutil::cl_release_event(writes[ci], "in set_device_buffer", true);
+      in_flight[ci] = false;
+    }
+  };
+
+  size_t ci = 0;
+  for (size_t first = 0; first < n_elements; first += chunk_elements)
+  {
+    size_t n = std::min(chunk_elements, n_elements - first);
+    // the chunk may still be being written from
+    wait(ci);
+    chunks[ci].resize(n);
+    fill_chunk<TFloat>(chunks[ci].data(), first, n, seed);
+    oclutil::cl_enqueue_write_buffer(command_queue,
+                                     buffer,
+                                     CL_FALSE,
+                                     first * sizeof(TFloat),
+                                     n * sizeof(TFloat),
+                                     chunks[ci].data(),
+                                     0,
+                                     nullptr,
+                                     &writes[ci],
+                                     "chunk write in set_device_buffer",
+                                     true);
+    in_flight[ci] = true;
+    // writes are only guaranteed to start once flushed
+    oclutil::cl_flush(command_queue, "in set_device_buffer", true);
+    ci = 1 - ci;
+  }
+  wait(0);
+  wait(1);
+}
+
 template <typename TFloat>
 void set_multigeom_abc(const MatData<TFloat>&       v_abc,
                        const std::vector<Geometry>& ggs,
@@ -150,5 +249,21 @@ set_multigeom_abc(const MatData<float>& v_abc, const std::vector<Geometry>&, con
 template void set_abcw(const MatData<double>& v_abcw, const Geometry& gg, const Offsets& toff);
 
 template void set_abcw(const MatData<float>& v_abcw, const Geometry& gg, const Offsets& toff);
+
+template void fill_chunk(float* chunk, size_t first, size_t n_elements, size_t seed);
+
+template void fill_chunk(double* chunk, size_t first, size_t n_elements, size_t seed);
+
+template void set_device_buffer<float>(cl_command_queue command_queue,
+                                       cl_mem           buffer,
+                                       size_t           n_elements,
+                                       size_t           seed,
+                                       size_t           chunk_elements);
+
+template void set_device_buffer<double>(cl_command_queue command_queue,
+                                        cl_mem           buffer,
+                                        size_t           n_elements,
+                                        size_t           seed,
+                                        size_t           chunk_elements);
 }
 }
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <miopengemm/error.hpp>
+#include <miopengemm/roofline.hpp>
+#include <miopengemm/simdevice.hpp>
+
+namespace MIOpenGEMM
+{
+namespace simdevice
+{
+
+oclutil::DevInfo get_devinfo(const std::string& identifier)
+{
+  oclutil::DevInfo devinfo(identifier, "simulated " + identifier, 64);
+  devinfo.device_version             = "simulated";
+  devinfo.driver_version             = "simulated";
+  devinfo.device_available           = true;
+  devinfo.device_global_mem_size     = size_t(4) * 1024 * 1024 * 1024;
+  devinfo.device_local_mem_size      = 65536;
+  devinfo.device_max_clock_frequency = 1050;
+  devinfo.device_max_compute_units   = 64;
+  devinfo.device_max_work_group_size = 256;
+  return devinfo;
+}
+
+Device::Device(const SimParams& params_, const oclutil::DevInfo& devinfo_)
+  : params(params_), devinfo(devinfo_), gen(params_.seed), nordis(1.0, std::max(params_.noise, 1e-9))
+{
+  if (devinfo.device_max_compute_units == 0 || devinfo.wg_atom_size == 0)
+  {
+    throw miog_error("simulated device requires non-zero compute units and wg_atom_size");
+  }
+}
+
+double Device::get_memory_time(double n_bytes) const
+{
+  return 1e3 * n_bytes / (1e9 * params.bandwidth);
+}
+
+double Device::get_main_time(const kerngen::Bundle& bundle) const
+{
+  const HyPas&         hp = bundle.hp;
+  const Geometry&      gg = bundle.gg;
+  const DerivedParams& dp = bundle.dp;
+
+  auto& ahp = hp.sus[Mat::E::A].vs;
+  auto& bhp = hp.sus[Mat::E::B].vs;
+  auto& chp = hp.sus[Mat::E::C].vs;
+
+  double fsb = gg.derived.float_size_bytes;
+  double ice = chp[NonChi::E::ICE];
+
+  // the work actually performed, including the overhang of edge tiles
+  double padded_m = dp.at(Mat::E::A).n_groups * dp.at(Mat::E::A).macro_tile_length;
+  double padded_n = dp.at(Mat::E::B).n_groups * dp.at(Mat::E::B).macro_tile_length;
+  double flops    = 2. * padded_m * padded_n * gg.k;
+
+  // every (macro tile) column of work groups reads all of a, every row all of b
+  double read_bytes =
+    fsb * gg.k * (padded_m * dp.at(Mat::E::B).n_groups + padded_n * dp.at(Mat::E::A).n_groups);
+  double write_bytes = fsb * gg.m * gg.n * (dp.main_does_beta_c_inc != 0 ? 2. : 1.);
+
+  // resident work groups per compute unit, limited by LDS, wavefront slots and registers
+  double lds_bytes = dp.main_n_lds_buffers * fsb *
+                     (dp.at(Mat::E::A).main_n_elements_in_padded_unroll +
+                      dp.at(Mat::E::B).main_n_elements_in_padded_unroll);
+  double waves_per_wg =
+    std::ceil(static_cast<double>(dp.main_n_work_items_per_workgroup) / devinfo.wg_atom_size);
+  double vgprs = (fsb / 4.) * (dp.main_micro_tile_area + ahp[Chi::E::MIC] + bhp[Chi::E::MIC] +
+                               dp.main_n_prefetch_registers) +
+                 24.;
+  double waves_per_simd_regs = std::max(1., std::floor(256. / vgprs));
+
+  double wgs_lds   = std::max(1., std::floor(devinfo.device_local_mem_size / lds_bytes));
+  double wgs_waves = std::max(1., std::floor(40. / waves_per_wg));
+  double wgs_regs  = std::max(1., std::floor(4. * waves_per_simd_regs / waves_per_wg));
+  double wgs_per_cu = std::min({wgs_lds, wgs_waves, wgs_regs});
+
+  // the final round of work groups only partially fills the device
+  double slots       = devinfo.device_max_compute_units * wgs_per_cu;
+  double rounds      = std::ceil(dp.main_n_work_groups / slots);
+  double utilisation = dp.main_n_work_groups / (rounds * slots);
+  if (dp.main_stream_k != 0)
+  {
+    // the work units are shared between the persistent work groups to within one
+    double units_per_wg = static_cast<double>(dp.main_n_stream_k_units) / dp.main_n_work_groups;
+    utilisation *= units_per_wg / std::ceil(units_per_wg);
+  }
+
+  // fewer than ~4 resident waves per SIMD do not hide latency, ~2 if the global loads of the
+  // next unroll are prefetched into registers
+  double latency_waves  = dp.main_n_prefetch_registers != 0 ? 8. : 16.;
+  double latency_hiding = std::min(1., wgs_per_cu * waves_per_wg / latency_waves);
+
+  // each step of the inner loop loads MIC_A + MIC_B values from LDS for MIC_A * MIC_B fmas,
+  // LDS tiles which are neither padded nor swizzled cause bank conflicts
+  double lds_a =
+    ahp[Chi::E::MIC] * (ahp[Chi::E::PAD] == 0 && ahp[Chi::E::SWZ] == Binary::E::NO ? 2. : 1.);
+  double lds_b =
+    bhp[Chi::E::MIC] * (bhp[Chi::E::PAD] == 0 && bhp[Chi::E::SWZ] == Binary::E::NO ? 2. : 1.);
+  double inner = dp.main_micro_tile_area / (dp.main_micro_tile_area + 0.5 * (lds_a + lds_b));
+
+  // two barriers per unroll, one if the LDS is double buffered
+  double unroll_eff = chp[NonChi::E::UNR] / (chp[NonChi::E::UNR] + 3. - dp.main_n_lds_buffers);
+  double mad_eff    = chp[NonChi::E::MAD] == Binary::E::YES ? 1.0 : 0.95;
+  // register spilling
+  double spill_eff = vgprs > 256. ? 0.3 : 1.0;
+
+  double compute_time = 1e3 * flops / (1e9 * params.peak_gflops * utilisation * latency_hiding *
+                                       inner * unroll_eff * mad_eff * spill_eff);
+
+  // vectorised global loads use the bus more efficiently
+  double vew_eff =
+    0.6 + 0.1 * (std::min<size_t>(ahp[Chi::E::VEW], 4) + std::min<size_t>(bhp[Chi::E::VEW], 4)) / 2.;
+  // and so do vectorised C writes
+  double c_vew_eff = std::max(vew_eff, 0.6 + 0.1 * std::min<size_t>(dp.main_c_vector_width, 4));
+  double memory_time =
+    get_memory_time(read_bytes) / vew_eff + get_memory_time(write_bytes) / c_vew_eff;
+
+  // split on k : atomic read-modify-write of C, contended ICE ways
+  double atomic_time = ice > 1 ? 4. * ice * get_memory_time(2. * fsb * gg.m * gg.n) : 0.;
+  // stream-K : atomic increments of C, contended only on the tiles shared by work groups
+  if (dp.main_stream_k != 0)
+  {
+    double n_tiles = dp.at(Mat::E::A).n_groups * dp.at(Mat::E::B).n_groups;
+    atomic_time    = 4. * (1. + std::min<double>(dp.main_n_work_groups, n_tiles) / n_tiles) *
+                  get_memory_time(2. * fsb * gg.m * gg.n);
+  }
+
+  return std::max(compute_time, memory_time) + atomic_time + params.launch_overhead;
+}
+
+std::array<double, KType::E::N> Device::get_modelled_times(const kerngen::Bundle& bundle) const
+{
+  std::array<double, KType::E::N> times;
+  times.fill(-1.);
+
+  // the preparation kernels (PREP those fused) only move memory
+  auto traffic = roofline::get_traffic(bundle);
+
+  for (auto& kblob : bundle.v_tgks)
+  {
+    double t;
+    switch (kblob.e_ktype)
+    {
+    case KType::E::WSA:
+    case KType::E::WSB:
+    case KType::E::BETAC:
+    case KType::E::PREP: t = get_memory_time(traffic[kblob.e_ktype].get_bytes()); break;
+    case KType::E::MAIN: t = get_main_time(bundle); break;
+    case KType::E::N:
+    default: throw miog_error("unrecognised KType in get_modelled_times");
+    }
+    times[kblob.e_ktype] = (kblob.e_ktype == KType::E::MAIN) ? t : t + params.launch_overhead;
+  }
+  return times;
+}
+
+double Device::get_tiny_time(const Geometry& gg) const
+{
+  double m            = gg.m;
+  double n            = gg.n;
+  double k            = gg.k;
+  double memory_time  = get_memory_time(gg.derived.float_size_bytes * ((m + n) * k + 2. * m * n));
+  double compute_time = 1e3 * 2. * m * n * k / (1e9 * params.peak_gflops);
+  return std::max(compute_time, memory_time) + params.launch_overhead;
+}
+
+double Device::sample(double modelled_time)
+{
+  if (params.noise <= 0)
+  {
+    return modelled_time;
+  }
+  return modelled_time * std::max(0.5, nordis(gen));
+}
+
+size_t Device::advance(double t)
+{
+  clock_ns += static_cast<size_t>(1e6 * t);
+  return clock_ns;
+}
+}
+}
@@ -32,6 +32,10 @@ std::string Solution::get_networkconfig_string() const
 
 std::string Solution::get_cache_entry_string() const
 {
+  if (is_tiny)
+  {
+    throw miog_error("Solution is the tiny kernel, its hyper-parameters are not a cache entry");
+  }
   return MIOpenGEMM::get_cache_entry_string(
     {devinfo.identifier, constraints, redirection::get_canonical(geometry)},
     hypas,
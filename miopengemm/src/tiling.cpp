@@ -40,8 +40,6 @@ void set_tile_dimensions_no_checks(size_t& tH, size_t& tW, size_t TH, size_t TW,
 
 std::tuple<bool, std::string> get_tileability(size_t TH, size_t TW, size_t tS)
 {
-  std::stringstream ss_tileable_status;
-
   if (tS == 0)
   {
     std::stringstream errm;
@@ -52,15 +50,17 @@ std::tuple<bool, std::string> get_tileability(size_t TH, size_t TW, size_t tS)
     throw miog_error(errm.str());
   }
 
-  std::string       set_ds("");
-  std::stringstream input_ss;
-  input_ss << '\n' << "TH : " << TH << " TW : " << TW << " tS : " << tS;
-  std::string input_string = input_ss.str();
+  // only made on failure, this is called for every kernel generated
+  auto get_input_string = [TH, TW, tS]() {
+    std::stringstream input_ss;
+    input_ss << '\n' << "TH : " << TH << " TW : " << TW << " tS : " << tS;
+    return input_ss.str();
+  };
 
   if ((TH * TW) % tS != 0)
   {
-    ss_tileable_status << "Areas of micro and macro tiles are incompatible : " << input_string;
-    std::make_tuple(false, ss_tileable_status.str());
+    return std::make_tuple(
+      false, "Areas of micro and macro tiles are incompatible : " + get_input_string());
   }
 
   size_t tH = 0;
@@ -69,8 +69,8 @@ std::tuple<bool, std::string> get_tileability(size_t TH, size_t TW, size_t tS)
 
   if (tH == 0)
   {
-    ss_tileable_status << "Impossible tiling problem in get_tile_dimensions : " << input_string;
-    std::make_tuple(false, ss_tileable_status.str());
+    return std::make_tuple(
+      false, "Impossible tiling problem in get_tile_dimensions : " + get_input_string());
   }
 
   if (tW > tH)
@@ -85,7 +85,8 @@ std::tuple<bool, std::string> get_tileability(size_t TH, size_t TW, size_t tS)
     std::stringstream err_ss;
     err_ss << "Problem in get_tileability."
            << " This isn't even non-tileable, this is a logic error. "
-           << "The found micro tile size is not consistent with the macro tile : " << input_string
+           << "The found micro tile size is not consistent with the macro tile : "
+           << get_input_string()
            << "   tH : " << tH << " tW  " << tW;
     throw miog_error(err_ss.str());
   }
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <string>
+#include <miopengemm/basegenerator.hpp>
+#include <miopengemm/tinygenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace tinygen
+{
+
+namespace
+{
+// at most this many elements of C
+const size_t max_c_elements = 64 * 64;
+// at most this many bytes of A and B in LDS
+const size_t max_lds_bytes = 32 * 1024;
+const size_t local_work_size = 256;
+const size_t max_n_work_groups = 4;
+}
+
+bool is_tiny(const Geometry& gg)
+{
+  // the tiny kernel reads B as a matrix
+  return !gg.conv.is_set() && gg.m * gg.n <= max_c_elements &&
+         (gg.m + gg.n) * gg.k * gg.derived.float_size_bytes <= max_lds_bytes;
+}
+
+class TinyGenerator : public basegen::BaseGenerator
+{
+
+  public:
+  TinyGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_)
+    : basegen::BaseGenerator(hp_, gg_, dp_)
+  {
+  }
+
+  private:
+  virtual void set_usage() override final
+  {
+    u_a     = true;
+    u_b     = true;
+    u_c     = true;
+    u_w     = false;
+    u_alpha = true;
+    u_beta  = true;
+  }
+
+  virtual void set_type() override final { type = "tiny"; }
+
+  virtual void setup_final() override final {}
+
+  virtual size_t get_local_work_size() override final { return local_work_size; }
+
+  virtual size_t get_n_work_groups() override final
+  {
+    return std::min(max_n_work_groups, (gg.m * gg.n + local_work_size - 1) / local_work_size);
+  }
+
+  virtual KType::E get_ktype() override final { return KType::E::MAIN; }
+
+  // the strides in A (B) along k and along m (n)
+  void append_stride_defns(emit::Emitter& ss, Mat::E emat_x, char perp)
+  {
+    char   X        = Mat::M().name[emat_x];
+    bool   pll_coal = gg.coal_is_pll_k(emat_x);
+    size_t ld       = gg.ldX[emat_x];
+    ss << "#define STRIDE_K_" << X << ' ' << (pll_coal ? 1 : ld) << '\n';
+    ss << "#define STRIDE_" << perp << '_' << X << ' ' << (pll_coal ? ld : 1) << '\n';
+  }
+
+  public:
+  virtual void append_kernelstring(emit::Emitter& ss) override final
+  {
+    // the elements of C are processed along its coalesced dimension
+    bool m_coal_c = (gg.tX[Mat::E::C] + gg.isColMajor) % 2 == 1;
+
+    ss << get_time_string();
+    ss << R"(
+/* ****************************************************
+* It performs all of GEMM, C <- alpha*A*B + beta*C, for
+* a tiny geometry. Each work group loads all of A and B
+* into LDS, then computes a slice of C.
+****************************************************** */
+)";
+    ss << "/* " << gg.get_string() << " */\n";
+    ss << "#define TFLOAT " << dp.t_float << '\n';
+    ss << "#define TINTA " << dp.tints[Mem::E::A] << '\n';
+    ss << "#define TINTB " << dp.tints[Mem::E::B] << '\n';
+    ss << "#define TINTC " << dp.tints[Mem::E::C] << '\n';
+    ss << "#define M " << gg.m << '\n';
+    ss << "#define N " << gg.n << '\n';
+    ss << "#define K " << gg.k << '\n';
+    append_stride_defns(ss, Mat::E::A, 'M');
+    append_stride_defns(ss, Mat::E::B, 'N');
+    ss << "#define STRIDE_M_C " << (m_coal_c ? 1 : gg.ldX[Mat::E::C]) << '\n';
+    ss << "#define STRIDE_N_C " << (m_coal_c ? gg.ldX[Mat::E::C] : 1) << '\n';
+    ss << "#define N_WORK_ITEMS_PER_WORKGROUP " << get_local_work_size() << '\n';
+    ss << "#define N_WORK_GROUPS " << get_n_work_groups() << '\n';
+
+    ss << "\n\n__attribute__((reqd_work_group_size(" << get_local_work_size() << ",1,1)))\n";
+    ss << "__kernel void " << kernelname;
+    append_fargs(ss);
+
+    ss << R"(
+{
+
+a += a_offset;
+b += b_offset;
+c += c_offset;
+
+/* all of A and B, contiguous along m and n respectively */
+__local TFLOAT localA[K*M];
+__local TFLOAT localB[K*N];
+
+const uint local_id = get_local_id(0);
+for (uint i = local_id; i < K*M; i += N_WORK_ITEMS_PER_WORKGROUP){
+localA[i] = a[(TINTA)(i % M)*STRIDE_M_A + (TINTA)(i / M)*STRIDE_K_A];
+}
+for (uint i = local_id; i < K*N; i += N_WORK_ITEMS_PER_WORKGROUP){
+localB[i] = b[(TINTB)(i % N)*STRIDE_N_B + (TINTB)(i / N)*STRIDE_K_B];
+}
+barrier(CLK_LOCAL_MEM_FENCE);
+
+/* consecutive work items process consecutive elements of C, along its coalesced dimension */
+for (uint e = get_group_id(0)*N_WORK_ITEMS_PER_WORKGROUP + local_id; e < M*N; e += N_WORK_GROUPS*N_WORK_ITEMS_PER_WORKGROUP){
+)";
+    if (m_coal_c)
+    {
+      ss << "const uint mi = e % M;\nconst uint ni = e / M;\n";
+    }
+    else
+    {
+      ss << "const uint ni = e % N;\nconst uint mi = e / N;\n";
+    }
+
+    ss << R"(TFLOAT acc = 0;
+for (uint z = 0; z < K; ++z){
+acc = mad(localA[z*M + mi], localB[z*N + ni], acc);
+}
+
+/* the beta scaling, fused */
+const TINTC index = (TINTC)mi*STRIDE_M_C + (TINTC)ni*STRIDE_N_C;
+if (beta >= 0 && beta <= 0){
+c[index] = alpha*acc;
+}
+else{
+c[index] = alpha*acc + beta*c[index];
+}
+}
+}
+)";
+  }
+};
+
+KernBlob get_tiny_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  if (!is_tiny(gg))
+  {
+    throw miog_error("get_tiny_kernelstring called with a geometry which is not tiny : " +
+                     gg.get_string());
+  }
+  TinyGenerator tg(hp, gg, dp);
+  tg.setup();
+  return tg.get_kernelstring();
+}
+}
+}
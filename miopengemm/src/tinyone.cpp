@@ -7,6 +7,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <random>
 #include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
@@ -58,9 +59,6 @@ void TinyOne<TFl>::initialise_common()
 
   gg.check_ldx_consistent();
 
-  c_copy.resize(mem_size[Mem::E::C] / sizeof(TFl));
-  std::memcpy(c_copy.data(), cpu_mem[Mem::E::C], mem_size[Mem::E::C]);
-
   opencl_memory_initialise();
 
   up_jinx.reset(new TinyZero(tgcq.command_queue,
@@ -128,17 +126,24 @@ TinyOne<TFl>::TinyOne(Geometry gg_,
 template <typename TFl>
 void TinyOne<TFl>::initialise_cpu_mem_from_scratch()
 {
+  // the cpu memories are set in set_generated_cpu_mem, if ever needed
+  generated = true;
+}
 
-  setabcw::set_abc<TFl>(
-    {&__cpu_mem[Mat::E::A], &__cpu_mem[Mat::E::B], &__cpu_mem[Mat::E::C]}, gg, toff);
+template <typename TFl>
+void TinyOne<TFl>::set_generated_cpu_mem()
+{
+  if (!generated || cpu_mem[Mat::E::A] != nullptr)
+  {
+    return;
+  }
 
-  //// why ?
-  // for (auto& x : __cpu_mem[Mat::E::B])
-  //{
-  // x *= 1000;
-  //}
   for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
   {
+    auto emem = Mem::mat_to_mem(emat);
+    __cpu_mem[emat].resize(mem_size[emem] / sizeof(TFl));
+    // the seed of a matrix is its enum, as in opencl_memory_initialise
+    setabcw::fill_chunk<TFl>(__cpu_mem[emat].data(), 0, __cpu_mem[emat].size(), emat);
     cpu_mem[emat] = __cpu_mem[emat].data();
   }
 }
@@ -185,6 +190,12 @@ void TinyOne<TFl>::opencl_memory_initialise()
   for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
   {
     Mem::E emem = Mem::mat_to_mem(emat);
+    if (generated)
+    {
+      setabcw::set_device_buffer<TFl>(
+        tgcq.command_queue, gpu_safemem[emem].clmem, mem_size[emem] / sizeof(TFl), emat);
+      continue;
+    }
     oclutil::cl_enqueue_write_buffer(tgcq.command_queue,
                                      gpu_safemem[emem].clmem,
                                      CL_TRUE,
@@ -213,6 +224,12 @@ std::vector<std::vector<double>> TinyOne<TFl>::benchgemm(const std::vector<HyPas
   return times_s;
 }
 
+template <typename TFl>
+void TinyOne<TFl>::compile(const HyPas& hp)
+{
+  up_jinx->compile(hp);
+}
+
 template <typename TFl>
 Solution TinyOne<TFl>::find1(const FindParams& find_params, const Constraints& constraints)
 {
@@ -221,9 +238,12 @@ Solution TinyOne<TFl>::find1(const FindParams& find_params, const Constraints& c
 }
 
 template <typename TFl>
-void TinyOne<TFl>::accuracy_test(const HyPas& hp)  //, const TFl* c_true_for_test)
+void TinyOne<TFl>::accuracy_test(const HyPas& hp, Verification::E verification)
 {
 
+  set_generated_cpu_mem();
+  c_copy.resize(mem_size[Mem::E::C] / sizeof(TFl));
+
   // copy the const cpu matrix to the gpu
   oclutil::SafeClEvent event_write_c_to_gpu("accuracy test write");
 
@@ -260,58 +280,56 @@ void TinyOne<TFl>::accuracy_test(const HyPas& hp)  //, const TFl* c_true_for_tes
                                   "enqueue read to c, in base_basegemm_with_accuracy_test",
                                   true);
 
-  // compute product on CPU.
-  std::vector<TFl> c_for_cpu_compute(mem_size[Mem::E::C] / sizeof(TFl));
-  std::memcpy(c_for_cpu_compute.data(), cpu_mem[Mat::E::C], mem_size[Mem::E::C]);
-
-  cpugemm::gemm<TFl>(gg,
-                     toff,
-                     cpu_mem[Mat::E::A],
-                     cpu_mem[Mat::E::B],
-                     c_for_cpu_compute.data(),
-                     Floating::get_default_alpha(),
-                     Floating::get_default_beta(),
-                     mowri);
-
-  auto c_true_for_test = c_for_cpu_compute.data();
-
-  // compute absolute GEMM : C <- alpha abs(A)abs(B) + beta abs(C).
-  std::vector<TFl> A_abs(mem_size[Mem::E::A] / sizeof(TFl));
-  std::memcpy(A_abs.data(), cpu_mem[Mat::E::A], mem_size[Mem::E::A]);
-  for (auto& x : A_abs)
-  {
-    x = std::abs(x);
-  }
+  std::stringstream errmss;
+  errmss << "accuracy test in TinyOne,\n" << gg.get_string() << '\n' << hp.get_string() << '\n';
 
-  std::vector<TFl> B_abs(mem_size[Mem::E::B] / sizeof(TFl));
-  std::memcpy(B_abs.data(), cpu_mem[Mat::E::B], mem_size[Mem::E::B]);
-  for (auto& x : B_abs)
+  // the sampled verifications need neither the full nor the absolute GEMM on the CPU
+  if (verification != Verification::E::FULL)
   {
-    x = std::abs(x);
+    oclutil::cl_wait_for_events(
+      1, &event_read_c_back.clevent, "in accuracy test, waiting GEMM gpu ", true);
+    size_t seed = std::random_device()();
+    auto   compare =
+      verification == Verification::E::SAMPLED ? accuracytests::sampled_compare<TFl>
+                                               : accuracytests::freivalds_compare<TFl>;
+    compare(gg,
+            toff,
+            cpu_mem[Mat::E::A],
+            cpu_mem[Mat::E::B],
+            cpu_mem[Mat::E::C],
+            c_copy.data(),
+            Floating::get_default_alpha(),
+            Floating::get_default_beta(),
+            verification == Verification::E::SAMPLED ? accuracytests::default_n_samples
+                                                     : accuracytests::default_n_projections,
+            seed,
+            errmss.str(),
+            mowri);
+    return;
   }
 
+  // compute product on CPU, and in the same pass the absolute GEMM :
+  // C_abs <- abs(alpha) abs(A)abs(B) + abs(beta) abs(C).
+  std::vector<TFl> c_for_cpu_compute(mem_size[Mem::E::C] / sizeof(TFl));
+  std::memcpy(c_for_cpu_compute.data(), cpu_mem[Mat::E::C], mem_size[Mem::E::C]);
   std::vector<TFl> C_abs(mem_size[Mem::E::C] / sizeof(TFl));
-  std::memcpy(C_abs.data(), cpu_mem[Mat::E::C], mem_size[Mem::E::C]);
-  for (auto& x : C_abs)
-  {
-    x = std::abs(x);
-  }
 
-  cpugemm::gemm<TFl>(gg,
-                     toff,
-                     A_abs.data(),
-                     B_abs.data(),
-                     C_abs.data(),
-                     std::abs(Floating::get_default_alpha()),
-                     std::abs(Floating::get_default_beta()),
-                     mowri);
+  cpugemm::gemm_with_abs<TFl>(gg,
+                              toff,
+                              cpu_mem[Mat::E::A],
+                              cpu_mem[Mat::E::B],
+                              c_for_cpu_compute.data(),
+                              C_abs.data(),
+                              Floating::get_default_alpha(),
+                              Floating::get_default_beta(),
+                              mowri);
+
+  auto c_true_for_test = c_for_cpu_compute.data();
 
   // make sure the read back is complete complete
   oclutil::cl_wait_for_events(
     1, &event_read_c_back.clevent, "in accuracy test, waiting GEMM gpu ", true);
 
-  std::stringstream errmss;
-  errmss << "accuracy test in TinyOne,\n" << gg.get_string() << '\n' << hp.get_string() << '\n';
   // compare cpu and gpu results
   accuracytests::elementwise_compare(gg,
                                      toff,
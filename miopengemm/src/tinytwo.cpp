@@ -55,13 +55,13 @@ std::vector<std::vector<double>> TinyTwo::benchgemm(const std::vector<HyPas>& hp
   }
 }
 
-void TinyTwo::accuracy_test(const HyPas& hp)
+void TinyTwo::accuracy_test(const HyPas& hp, Verification::E verification)
 {
 
   switch (active_type)
   {
-  case 'f': f_moa->accuracy_test(hp); break;
-  case 'd': d_moa->accuracy_test(hp); break;
+  case 'f': f_moa->accuracy_test(hp, verification); break;
+  case 'd': d_moa->accuracy_test(hp, verification); break;
   default: throw miog_error("unrecognised floattype char in TinyTwo accuracy_test with 1 parm");
   }
 }
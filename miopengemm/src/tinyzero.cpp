@@ -3,9 +3,11 @@
  *******************************************************************************/
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <iomanip>
 #include <limits>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <sstream>
 #include <thread>
@@ -18,6 +20,7 @@
 #include <miopengemm/findparams.hpp>
 #include <miopengemm/graph.hpp>
 #include <miopengemm/kernelcache.hpp>
+#include <miopengemm/kernelcachefile.hpp>
 #include <miopengemm/kernelstring.hpp>
 #include <miopengemm/miogemm.hpp>
 #include <miopengemm/nearest.hpp>
@@ -36,13 +39,98 @@
 namespace MIOpenGEMM
 {
 
+namespace
+{
+
+// The Tracer of find0 when it traces to $MIOPENGEMM_TRACE (see tracer.hpp) : set on the
+// TinyZero on construction, written and unset on destruction, so also when find0 throws.
+class EnvTracer
+{
+  public:
+  EnvTracer(TinyZero& tz_, owrite::Writer& mowri_, const std::string& path_)
+    : tz(tz_), mowri(mowri_), path(path_), tracer(std::make_shared<trace::Tracer>())
+  {
+    tz.set_tracer(tracer);
+  }
+
+  ~EnvTracer()
+  {
+    tz.set_tracer(nullptr);
+    try
+    {
+      tracer->write(path);
+      mowri << "wrote trace of find to " << path << Endl;
+    }
+    catch (const miog_error& e)
+    {
+      mowri << e.what() << Endl;
+    }
+  }
+
+  EnvTracer(const EnvTracer&) = delete;
+  EnvTracer& operator=(const EnvTracer&) = delete;
+
+  private:
+  TinyZero&                      tz;
+  owrite::Writer&                mowri;
+  std::string                    path;
+  std::shared_ptr<trace::Tracer> tracer;
+};
+}
+
 void   FindTracker::start() { timer.start(); }
 double FindTracker::get_elapsed() const { return timer.get_elapsed(); }
 
-void FindTracker::incr_descents() { ++descents; }
+void FindTracker::incr_descents()
+{
+  ++descents;
+  if (tracer != nullptr)
+  {
+    tracer->instant("descent done", "find", {{"descents", std::to_string(descents)}});
+  }
+}
+
 void FindTracker::incr_kernels() { ++kernels; }
 
 size_t FindTracker::get_descents() const { return descents; }
+size_t FindTracker::get_kernels() const { return kernels; }
+
+void FindTracker::record(double gflops)
+{
+  if (records.size() == 0 || gflops > records.back().second)
+  {
+    records.emplace_back(timer.get_elapsed(), gflops);
+    if (tracer != nullptr)
+    {
+      tracer->counter("best gflops", gflops);
+    }
+  }
+}
+
+double FindTracker::get_time_to_fraction_of_best(double fraction) const
+{
+  if (records.size() == 0)
+  {
+    throw miog_error("no records in get_time_to_fraction_of_best");
+  }
+  for (auto& x : records)
+  {
+    if (x.second >= fraction * records.back().second)
+    {
+      return x.first;
+    }
+  }
+  return records.back().first;
+}
+
+double FindTracker::get_best_gflops() const
+{
+  if (records.size() == 0)
+  {
+    throw miog_error("no records in get_best_gflops");
+  }
+  return records.back().second;
+}
 
 std::string FindTracker::get_string() const
 {
@@ -109,10 +197,39 @@ TinyZero::TinyZero(cl_command_queue command_queue_,
     command_queue, context, device_id, mowri, true);
 
   programs = Programs(device_id, context, mowri);
+  peaks    = roofline::get_peaks(devinfo, gg.floattype);
+}
+
+TinyZero::TinyZero(std::shared_ptr<simdevice::Device> simdev,
+                   const Geometry                     gg_,
+                   const Offsets                      toff_,
+                   owrite::Writer&                    mowri_)
+  : command_queue(nullptr),
+    gg(gg_),
+    toff(toff_),
+    gpum(nullptr, nullptr, nullptr, false, nullptr, 0, nullptr),
+    devinfo(simdev->devinfo),
+    mowri(mowri_),
+    programs(simdev, mowri_)
+{
+  peaks.gflops    = simdev->params.peak_gflops;
+  peaks.bandwidth = simdev->params.bandwidth;
+}
+
+void TinyZero::set_tracer(std::shared_ptr<trace::Tracer> tracer_)
+{
+  tracer          = tracer_;
+  programs.tracer = tracer_;
 }
 
 void TinyZero::address_check_valid()
 {
+  // there are no memories on the simulated device
+  if (programs.is_simulated())
+  {
+    return;
+  }
+
   for (auto x : {Mem::E::A, Mem::E::B})
   {
     if (gpum[Mem::E::C] == gpum[x])
@@ -158,7 +275,7 @@ void TinyZero::address_check_valid()
 void TinyZero::address_check_valid_and_reliable()
 {
   address_check_valid();
-  if (gpum[Mem::E::A] == gpum[Mem::E::B])
+  if (!programs.is_simulated() && gpum[Mem::E::A] == gpum[Mem::E::B])
   {
     throw miog_error("in address_check_valid_and_reliable, a and b are the same. this will "
                      "effect kernel run time, not sure if this should be allowed, so throwing");
@@ -203,6 +320,22 @@ std::string TinyZero::get_run_time_string(cl_int status)
   return ss.str();
 }
 
+std::string TinyZero::get_roofline_string() const
+{
+  std::vector<roofline::Point> points;
+  for (auto& act_ind : programs.act_inds)
+  {
+    auto& v_times = kernel_times.ktimes[act_ind].v_times;
+    if (v_times.size() != 0)
+    {
+      points.emplace_back(static_cast<KType::E>(act_ind),
+                          traffic[act_ind],
+                          *std::min_element(v_times.begin(), v_times.end()));
+    }
+  }
+  return roofline::get_string(points, peaks);
+}
+
 oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
                                     std::vector<double>&             all_times,
                                     const Halt&                      hl,
@@ -225,6 +358,8 @@ oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
       throw miog_error("zero kernels active : internal logic error");
     }
 
+    trace::Scope run(tracer.get(), "run", "run");
+
     oclutil::SafeClEvent safe_last_event("Event to block on (final kernel) in find");
     safe_last_event.clevent = cl_event{};
 
@@ -246,7 +381,10 @@ oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
 
     else if (oclr.success == CL_OUT_OF_RESOURCES)
     {
-      oclutil::cl_flush(command_queue, "cl flushing in core gemm loop", true);
+      if (!programs.is_simulated())
+      {
+        oclutil::cl_flush(command_queue, "cl flushing in core gemm loop", true);
+      }
       oclr.message += " (CL_OUT_OF_RESOURCES in true_core) ";
       return oclr;
     }
@@ -262,13 +400,17 @@ oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
       throw miog_error(ss.str());
     }
 
-    oclutil::cl_flush(command_queue, "cl flush in core gemm loop", true);
+    if (!programs.is_simulated())
+    {
+      oclutil::cl_flush(command_queue, "cl flush in core gemm loop", true);
+    }
 
     // act on the results string.
     acton(get_run_time_string(oclr.success));
 
     ++runi;
     all_times.push_back(kernel_times.extime);
+    run.add_arg("time [ms]", std::to_string(kernel_times.extime));
   }
 
   auto   best_time = *std::min_element(all_times.begin(), all_times.end());
@@ -280,25 +422,39 @@ oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
   return {};
 }
 
-std::vector<double> TinyZero::benchgemm(const HyPas& hp, const Halt& hl)
+kerngen::Bundle TinyZero::get_compiled_bundle(const HyPas& hp)
 {
-
-  address_check_valid();
   Derivabilty dblt(hp, gg);
   if (dblt.is_derivable == false)
   {
     throw miog_error("Non-derivable in benchgemm : " + dblt.msg);
   }
 
+  double          t_generate = tracer == nullptr ? 0 : tracer->now();
   kerngen::Bundle bundle(hp, gg);
+  if (tracer != nullptr)
+  {
+    tracer->complete("generate", "generate", t_generate, {{"hp", hp.get_string()}});
+  }
 
-  architests::Stat atr(command_queue, bundle.dp, gg, hp);
+  architests::Stat atr(devinfo, bundle.dp, gg, hp);
   if (!atr.is_good)
   {
     throw miog_error(atr.msg);
   }
 
-  auto compstat = programs.update(bundle.v_tgks);
+  programs.update(bundle);
+  traffic = roofline::get_traffic(bundle);
+  return bundle;
+}
+
+void TinyZero::compile(const HyPas& hp) { get_compiled_bundle(hp); }
+
+std::vector<double> TinyZero::benchgemm(const HyPas& hp, const Halt& hl)
+{
+
+  address_check_valid();
+  auto bundle = get_compiled_bundle(hp);
 
   auto all_kern_args = get_all_kern_args(bundle.v_tgks);
 
@@ -307,7 +463,9 @@ std::vector<double> TinyZero::benchgemm(const HyPas& hp, const Halt& hl)
         << "Entering the core gemm loops" << Endl << get_run_times_heading();
 
   std::vector<double> all_times;
+  kernel_times.reset_times();
   true_core([this](std::string x) { mowri << x << '\n'; }, all_times, hl, all_kern_args);
+  mowri << get_roofline_string() << Flush;
   return all_times;
 }
 
@@ -342,7 +500,16 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
 
   address_check_valid_and_reliable();
 
-  FindTracker ftrack;
+  // trace to $MIOPENGEMM_TRACE if no tracer is set. find_scope ends before env_tracer writes
+  const char*                trace_path = std::getenv("MIOPENGEMM_TRACE");
+  std::unique_ptr<EnvTracer> env_tracer;
+  if (tracer == nullptr && trace_path != nullptr && *trace_path != '\0')
+  {
+    env_tracer.reset(new EnvTracer(*this, mowri, trace_path));
+  }
+  trace::Scope find_scope(tracer.get(), "find0", "find", {{"geometry", gg.get_string()}});
+
+  FindTracker ftrack(tracer);
   ftrack.start();
   std::vector<Solution> v_solns;
 
@@ -359,9 +526,16 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
 
     double allotted_sd = std::max(1.0, fparms.hl_outer.max_time - ftrack.get_elapsed());
 
+    // a descent from a random start is a restart
+    trace::Scope descent(tracer.get(),
+                         warmstart ? "descent (warmstart)" : "descent (restart)",
+                         "find",
+                         warmstart ? trace::Args{{"rank", std::to_string(warmstart_rank)}}
+                                   : trace::Args{});
     auto soln = single_descent_find(
       allotted_sd, constraints, fparms.hl_core, ftrack, fparms.sumstat, warmstart, warmstart_rank);
     v_solns.emplace_back(soln);
+    descent.add_arg("gflops", std::to_string(gg.get_gflops(soln.extime / 1000.)));
     ftrack.incr_descents();
 
     if (warmstart)
@@ -370,6 +544,8 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
     }
   }
 
+  last_ftrack = ftrack;
+
   double              best_gflops     = 0;
   size_t              best_soln_index = 0;
   std::vector<double> soln_gflops;
@@ -404,6 +580,16 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
     {devinfo.identifier, constraints, gg}, v_solns[best_soln_index].hypas, is_not_canonical);
   mowri.bw[OutPart::CCH] << "\n -- snip -- -- -- snip --\n\n\n" << Endl;
 
+  // the user layer of the kernel cache (see kernelcachefile.hpp)
+  std::string user_cache_path = cachefile::get_user_path();
+  if (user_cache_path != "")
+  {
+    cachefile::append(user_cache_path,
+                      {devinfo.identifier, constraints, gg},
+                      v_solns[best_soln_index].hypas.get_reflected(is_not_canonical));
+    mowri << "appended solution to user kernel cache " << user_cache_path << Endl;
+  }
+
   return v_solns[best_soln_index];
 }
 
@@ -497,7 +683,12 @@ Solution TinyZero::single_descent_find(double             allotted_time,
         throw miog_error(errm.str());
       }
 
+      double          t_generate = tracer == nullptr ? 0 : tracer->now();
       kerngen::Bundle bundle(hp_curr, gg);
+      if (tracer != nullptr)
+      {
+        tracer->complete("generate", "generate", t_generate, {{"hp", hp_curr.get_string()}});
+      }
       // the OpenCL string was succesfully generated,
       // we can now attempt to compile and benchmark it
       ++single_descent_counter;
@@ -506,16 +697,21 @@ Solution TinyZero::single_descent_find(double             allotted_time,
             << timer.get_elapsed() << std::setprecision(6) << "s]\t" << hp_curr.get_string()
             << Endl;
 
-      architests::Stat atr(command_queue, bundle.dp, gg, hp_curr);
+      architests::Stat atr(devinfo, bundle.dp, gg, hp_curr);
       if (atr.is_good == false)
       {
         mowri << "architest failed: " << atr.msg << Endl;
+        if (tracer != nullptr)
+        {
+          tracer->instant("architest failed", "generate", {{"message", atr.msg}});
+        }
         ++hfi;
         continue;
       }
 
       // kernel compilation
-      auto compstat = programs.update(bundle.v_tgks);
+      auto compstat = programs.update(bundle);
+      traffic       = roofline::get_traffic(bundle);
 
       auto all_kern_args = get_all_kern_args(bundle.v_tgks);
 
@@ -528,6 +724,9 @@ Solution TinyZero::single_descent_find(double             allotted_time,
       kernel_times.reset_times();
       std::vector<std::string> summary;
 
+      // the benchmark runs of hp_curr, and the reporting of their times
+      trace::Scope benchmark(tracer.get(), "benchmark", "run");
+
       auto oclr = true_core([&summary, &v_t_total](std::string x) { summary.push_back(x); },
                             v_t_total,
                             core_halt,
@@ -552,6 +751,8 @@ Solution TinyZero::single_descent_find(double             allotted_time,
         break;
       case SummStat::E::N: throw miog_error("N not allowed in SummStat in find ");
       }
+      benchmark.add_arg(SummStat::M().lcase_name[sumstat] + " time [ms]",
+                        std::to_string(k_seconds));
 
       mowri << get_run_times_heading() << Flush;
       for (size_t ir = 0; ir < summary.size(); ++ir)
@@ -577,10 +778,12 @@ Solution TinyZero::single_descent_find(double             allotted_time,
 
         best_solns_path.emplace_back(gg, k_seconds, bundle.v_tgks, hp_curr, devinfo, constraints);
         disco_times.push_back(timer.get_elapsed());
+        mowri << get_roofline_string() << Flush;
       }
 
       ++hfi;
       ftrack.incr_kernels();
+      ftrack.record(gg.get_gflops(k_seconds / 1000.));
     }
 
     if (improvement_found_on_front == true && allotted_time > timer.get_elapsed())
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <miopengemm/error.hpp>
+#include <miopengemm/tracer.hpp>
+
+namespace MIOpenGEMM
+{
+namespace trace
+{
+
+namespace
+{
+
+std::string get_quoted(const std::string& x)
+{
+  std::stringstream ss;
+  ss << '"';
+  for (char c : x)
+  {
+    switch (c)
+    {
+    case '"': ss << "\\\""; break;
+    case '\\': ss << "\\\\"; break;
+    case '\n': ss << "\\n"; break;
+    case '\t': ss << "\\t"; break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+           << std::dec << std::setfill(' ');
+      }
+      else
+      {
+        ss << c;
+      }
+    }
+  }
+  ss << '"';
+  return ss.str();
+}
+
+std::string get_args_string(const Args& args)
+{
+  if (args.size() == 0)
+  {
+    return "";
+  }
+  std::stringstream ss;
+  ss << ",\"args\":{";
+  for (size_t i = 0; i < args.size(); ++i)
+  {
+    ss << (i == 0 ? "" : ",") << get_quoted(args[i].first) << ':' << get_quoted(args[i].second);
+  }
+  ss << '}';
+  return ss.str();
+}
+
+std::string get_time_string(double t)
+{
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << t;
+  return ss.str();
+}
+}
+
+Tracer::Tracer() { timer.start(); }
+
+double Tracer::now() const { return 1e6 * timer.get_elapsed(); }
+
+void Tracer::add(const std::string& name,
+                 const std::string& category,
+                 char               phase,
+                 double             t,
+                 const std::string& tail)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto id   = std::this_thread::get_id();
+  auto iter = tids.find(id);
+  if (iter == tids.end())
+  {
+    int tid = static_cast<int>(tids.size());
+    iter    = tids.emplace(id, tid).first;
+    events.push_back("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" +
+                     std::to_string(tid) + ",\"args\":{\"name\":\"thread " +
+                     std::to_string(tid) + "\"}}");
+  }
+
+  std::stringstream ss;
+  ss << "{\"name\":" << get_quoted(name) << ",\"cat\":" << get_quoted(category) << ",\"ph\":\""
+     << phase << "\",\"pid\":1,\"tid\":" << iter->second << ",\"ts\":" << get_time_string(t)
+     << tail << '}';
+  events.push_back(ss.str());
+}
+
+void Tracer::complete(const std::string& name,
+                      const std::string& category,
+                      double             t_start,
+                      const Args&        args)
+{
+  std::string tail = ",\"dur\":" + get_time_string(now() - t_start) + get_args_string(args);
+  add(name, category, 'X', t_start, tail);
+}
+
+void Tracer::instant(const std::string& name, const std::string& category, const Args& args)
+{
+  add(name, category, 'i', now(), ",\"s\":\"t\"" + get_args_string(args));
+}
+
+void Tracer::counter(const std::string& name, double value)
+{
+  // inf and nan are not JSON
+  std::stringstream tail;
+  tail << ",\"args\":{" << get_quoted(name) << ':' << (std::isfinite(value) ? value : 0.) << '}';
+  add(name, "counter", 'C', now(), tail.str());
+}
+
+size_t Tracer::get_n_events() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return events.size() - tids.size();
+}
+
+std::string Tracer::get_json() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  std::stringstream           ss;
+  ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    ss << events[i] << (i + 1 == events.size() ? "\n" : ",\n");
+  }
+  ss << "]}\n";
+  return ss.str();
+}
+
+void Tracer::write(const std::string& filename) const
+{
+  std::ofstream file(filename, std::ios::out);
+  if (!file.good())
+  {
+    throw miog_error("failed to open trace file " + filename);
+  }
+  file << get_json();
+}
+
+Scope::Scope(Tracer* tracer_, std::string name_, std::string category_, Args args_)
+  : tracer(tracer_),
+    name(std::move(name_)),
+    category(std::move(category_)),
+    args(std::move(args_)),
+    t_start(tracer_ == nullptr ? 0 : tracer_->now())
+{
+}
+
+Scope::~Scope()
+{
+  if (tracer != nullptr)
+  {
+    tracer->complete(name, category, t_start, args);
+  }
+}
+
+void Scope::add_arg(const std::string& key, const std::string& value)
+{
+  if (tracer != nullptr)
+  {
+    args.emplace_back(key, value);
+  }
+}
+}
+}
@@ -0,0 +1,120 @@
+"""
+Convert the .cachetxt kernel cache files into pre-parsed tables, included by kernelcache.cpp
+so that initialising the builtin kernel cache does no string parsing.
+
+usage : python cachetables.py output.inc cache1.cachetxt [cache2.cachetxt ...]
+"""
+
+import re
+import sys
+
+floattypes = {"32": "f", "64": "d"}
+geometry_keys = ["colMaj", "tA", "tB", "tC", "m", "n", "k", "lda", "ldb", "ldc", "ws", "f"]
+
+
+def get_key_vals(s):
+  """ `MIC4_PAD1' -> [("MIC", "4"), ("PAD", "1")] """
+  key_vals = []
+  for frag in s.split("_"):
+    match = re.match(r"^([a-zA-Z]+)(\d+)$", frag)
+    if not match:
+      raise RuntimeError("cannot split `%s' (in `%s') into key and value" % (frag, s))
+    key_vals.append((match.group(1), match.group(2)))
+  return key_vals
+
+
+def get_entries(filename):
+  """ the 6 strings (device, constraints, geometry, hp A, hp B, hp C) of each kc.add """
+  text = re.sub(r"//[^\n]*", "", open(filename).read())
+  entries = []
+  for block in text.split("kc.add(")[1:]:
+    strings = re.findall(r'"([^"]*)"', block.split(");")[0])
+    if len(strings) != 6:
+      raise RuntimeError("expected 6 strings in cache entry of %s, found %s" % (filename, strings))
+    entries.append(strings)
+  return entries
+
+
+class Tables:
+  def __init__(self):
+    self.devices = []
+    self.constraints = []
+    self.hp_keys = [None, None, None]
+    self.rows = []
+
+  def get_index(self, values, x):
+    if x not in values:
+      values.append(x)
+    return values.index(x)
+
+  def get_hp_values(self, emat, s):
+    key_vals = get_key_vals(s)
+    keys = [k for k, v in key_vals]
+    if self.hp_keys[emat] is None:
+      self.hp_keys[emat] = keys
+    elif self.hp_keys[emat] != keys:
+      raise RuntimeError("hyper-parameter keys of `%s' differ from those of earlier entries" % s)
+    return [v for k, v in key_vals]
+
+  def add(self, strings):
+    device, constraints, geometry, hpA, hpB, hpC = strings
+    gg = dict(get_key_vals(geometry))
+    if "NHWC" in gg:
+      raise RuntimeError("convolution geometry `%s' cannot be in the builtin cache, whose tables "
+                         "have no convolution fields : use a site or user cache file" % geometry)
+    if sorted(gg.keys()) != sorted(geometry_keys):
+      raise RuntimeError("unexpected keys in geometry string `%s'" % geometry)
+    if gg["f"] not in floattypes:
+      raise RuntimeError("unrecognised float size in geometry string `%s'" % geometry)
+
+    row = [str(self.get_index(self.devices, device)), str(self.get_index(self.constraints, constraints))]
+    row += [gg[key] for key in geometry_keys[0:-1]]
+    row.append("'%s'" % floattypes[gg["f"]])
+    chis = ["{" + ", ".join(self.get_hp_values(emat, hp)) + "}" for emat, hp in enumerate([hpA, hpB])]
+    row.append("{" + ", ".join(chis) + "}")
+    row.append("{" + ", ".join(self.get_hp_values(2, hpC)) + "}")
+    self.rows.append("{" + ", ".join(row) + "}")
+
+  def get_string_array(self, name, values):
+    return "const char* const %s[] = {%s};\n" % (name, ", ".join('"%s"' % x for x in values))
+
+  def get_string(self, sources):
+    s = "// Generated by python/cachetables.py from %s. Do not edit.\n\n" % ", ".join(sources)
+    s += "// clang-format off\n"
+    s += self.get_string_array("builtin_devices", self.devices)
+    s += self.get_string_array("builtin_constraints", self.constraints)
+    s += self.get_string_array("builtin_chi_keys", self.hp_keys[0])
+    s += self.get_string_array("builtin_nonchi_keys", self.hp_keys[2])
+    s += "constexpr PackedCacheEntry builtin_entries[] = {\n"
+    s += ",\n".join(self.rows)
+    s += "};\n"
+    s += "// clang-format on\n"
+    return s
+
+
+def main(argv):
+  if len(argv) < 3:
+    raise RuntimeError("usage : python cachetables.py output.inc input.cachetxt [...]")
+
+  tables = Tables()
+  for filename in argv[2:]:
+    for strings in get_entries(filename):
+      tables.add(strings)
+
+  if tables.hp_keys[0] != tables.hp_keys[1]:
+    raise RuntimeError("hyper-parameter keys of A and B differ")
+
+  sources = [re.sub(r".*[/\\]", "", x) for x in argv[2:]]
+  contents = tables.get_string(sources)
+
+  # only write if changed, so that kernelcache.cpp is not needlessly recompiled
+  try:
+    if open(argv[1]).read() == contents:
+      return
+  except IOError:
+    pass
+  open(argv[1], "w").write(contents)
+
+
+if __name__ == "__main__":
+  main(sys.argv)
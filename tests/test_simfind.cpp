@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <miopengemm/bundle.hpp>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/geometries.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/graph.hpp>
+#include <miopengemm/simdevice.hpp>
+#include <miopengemm/tinyzero.hpp>
+
+// Runs find on the simulated device (no GPU required), reporting the efficiency of the search
+// strategy : kernels benchmarked per second and the time to find a kernel within 90% of the best.
+// Then checks that without noise and with a fixed seed, find is deterministic and returns the
+// kernel fastest according to the model of the simulated device.
+
+int main()
+{
+
+  using namespace MIOpenGEMM;
+
+  owrite::Writer mowri(Ver::E::SILENT, "");
+
+  simdevice::SimParams simparams;
+  simparams.compile_delay = 0.002;
+  auto simdev =
+    std::make_shared<simdevice::Device>(simparams, simdevice::get_devinfo("gfx803"));
+
+  std::vector<Geometry> geometries = get_conv_geometries();
+  geometries.resize(4);
+  geometries.emplace_back(get_squareNN_geometry<float>(2048));
+
+  for (auto& gg : geometries)
+  {
+    TinyZero tzero(simdev, gg, get_zero_offsets(), mowri);
+    Solution soln = tzero.find0({""}, get_at_least_n_restarts(3));
+
+    if (!is_dvble(soln.hypas, gg))
+    {
+      throw miog_error("simulated find returned a non-derivable solution : " +
+                       soln.hypas.get_string());
+    }
+
+    auto&  ftrack  = tzero.get_find_tracker();
+    double elapsed = ftrack.get_elapsed();
+    std::cout << gg.get_string() << "\n  kernels : " << ftrack.get_kernels()
+              << "  kernels/s : " << std::setprecision(4) << ftrack.get_kernels() / elapsed
+              << "  time to 90% of best [s] : " << ftrack.get_time_to_fraction_of_best(0.9)
+              << "  best gflops : " << gg.get_gflops(soln.extime / 1000.) << std::endl;
+  }
+
+  simparams.noise = 0;
+  for (auto& gg : {geometries[0], geometries.back()})
+  {
+    std::vector<std::string> hypas;
+    std::vector<double>      extimes;
+    std::vector<size_t>      kernels;
+    for (size_t i = 0; i < 2; ++i)
+    {
+      set_random_seed(1011);
+      auto quiet =
+        std::make_shared<simdevice::Device>(simparams, simdevice::get_devinfo("gfx803"));
+      TinyZero tzero(quiet, gg, get_zero_offsets(), mowri);
+      Solution soln = tzero.find0({""}, get_at_least_n_restarts(3));
+      auto&    ftrack = tzero.get_find_tracker();
+
+      double modelled = 0;
+      for (auto t : quiet->get_modelled_times(kerngen::Bundle(soln.hypas, gg)))
+      {
+        modelled += std::max(t, 0.);
+      }
+      // the simulated clock counts whole ns
+      if (std::abs(soln.extime - modelled) > 1e-5 ||
+          std::abs(gg.get_gflops(soln.extime / 1000.) - ftrack.get_best_gflops()) >
+            1e-9 * ftrack.get_best_gflops())
+      {
+        std::stringstream errm;
+        errm << "simulated find returned a kernel of " << soln.extime << " [ms], modelled "
+             << modelled << " [ms], while the best benchmarked ran at "
+             << ftrack.get_best_gflops() << " gflops";
+        throw miog_error(errm.str());
+      }
+      hypas.push_back(soln.hypas.get_string());
+      extimes.push_back(soln.extime);
+      kernels.push_back(ftrack.get_kernels());
+    }
+
+    if (hypas[0] != hypas[1] || extimes[0] != extimes[1] || kernels[0] != kernels[1])
+    {
+      throw miog_error("simulated find is not deterministic with a fixed seed on " +
+                       gg.get_string() + " : " + hypas[0] + " and " + hypas[1]);
+    }
+  }
+
+  return 0;
+}